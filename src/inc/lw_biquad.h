@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * Filename              :   lw_biquad.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_biquad.h
+ *  @brief This module declares an interface to design and run cascades of
+ *         biquad filters on q1.15 and q1.31 data
+ */
+
+#ifndef LW_BIQUAD_H_
+#define LW_BIQUAD_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_biquad
+ * \brief           Biquad filter cascades
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define BIQUAD_Q15_COEF_Q   14u   /**< coefficient format of q1.15 cascades */
+#define BIQUAD_Q31_COEF_Q   29u   /**< coefficient format of q1.31 cascades */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/**
+ * @brief  Number of states of a cascade
+ * @param  n_sections: number of sections
+ * @param  n_channels: number of channels
+ */
+#define BIQUAD_STATE_SIZE(n_sections, n_channels) \
+  (4u * (uint32_t)(n_sections) * (uint32_t)(n_channels))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Biquad response type definition
+ */
+typedef enum {
+  BIQUAD_LOWPASS = 0,   /**< second order low-pass */
+  BIQUAD_HIGHPASS,      /**< second order high-pass */
+  BIQUAD_BANDPASS,      /**< band-pass with unity peak gain */
+  BIQUAD_NOTCH,         /**< notch */
+  BIQUAD_PEAK           /**< peaking, gain_db < 0 for anti-resonance */
+} biquad_type_t;
+
+/**
+ * @brief  Biquad coefficients in floating point, normalized to a0 = 1:
+ *         H(z) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+ */
+typedef struct {
+  double b0;
+  double b1;
+  double b2;
+  double a1;
+  double a2;
+} biquad_design_t;
+
+/**
+ * @brief  Biquad coefficients for q1.15 data, usually in q.14 format
+ */
+typedef struct {
+  int16_t b0;
+  int16_t b1;
+  int16_t b2;
+  int16_t a1;
+  int16_t a2;
+} biquad_q15_coef_t;
+
+/**
+ * @brief  Biquad coefficients for q1.31 data, usually in q.29 format
+ */
+typedef struct {
+  int32_t b0;
+  int32_t b1;
+  int32_t b2;
+  int32_t a1;
+  int32_t a2;
+} biquad_q31_coef_t;
+
+/**
+ * @brief  Cascade of direct form I biquads on q1.15 data. Each channel runs
+ *         the same sections; the samples of the channels are interleaved.
+ *         The states are stored section by section as x[n-1], x[n-2],
+ *         y[n-1] and y[n-2] arrays of n_channels values, so the update
+ *         vectorizes across the channels. The 16-bit coefficients move poles
+ *         close to z = 1 noticeably (below about fs/100): those sections
+ *         belong in a q1.31 cascade.
+ */
+typedef struct {
+  const biquad_q15_coef_t *coef;  /**< n_sections coefficient sets */
+  int16_t *state;                 /**< BIQUAD_STATE_SIZE states */
+  uint8_t n_sections;             /**< number of sections */
+  uint8_t shift;                  /**< fractional bits of the coefficients */
+  uint16_t n_channels;            /**< number of channels */
+} biquad_q15_t;
+
+/**
+ * @brief  Cascade of direct form I biquads on q1.31 data, with the same
+ *         layout as biquad_q15_t
+ */
+typedef struct {
+  const biquad_q31_coef_t *coef;  /**< n_sections coefficient sets */
+  int32_t *state;                 /**< BIQUAD_STATE_SIZE states */
+  uint8_t n_sections;             /**< number of sections */
+  uint8_t shift;                  /**< fractional bits of the coefficients */
+  uint16_t n_channels;            /**< number of channels */
+} biquad_q31_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function designs a biquad with the bilinear transform
+ *         (audio EQ cookbook formulas). It is meant to run offline or at
+ *         start-up.
+ * @param  design: coefficients to compute
+ * @param  type: response type
+ * @param  f0: cut-off, center or notch frequency in Hz
+ * @param  fs: sampling frequency in Hz
+ * @param  quality: quality factor (0.7071 for a Butterworth low-pass)
+ * @param  gain_db: peak gain of BIQUAD_PEAK in dB, unused otherwise
+ */
+void lw_biquad_design(biquad_design_t *design, biquad_type_t type, double f0,
+                      double fs, double quality, double gain_db);
+
+/**
+ * @brief  This function quantizes biquad coefficients for q1.15 data
+ * @param  coef: coefficients to compute
+ * @param  design: floating point coefficients
+ * @param  q: fractional bits of the coefficients (BIQUAD_Q15_COEF_Q)
+ */
+void lw_biquad_q15_coef(biquad_q15_coef_t *coef, const biquad_design_t *design,
+                        uint8_t q);
+
+/**
+ * @brief  This function quantizes biquad coefficients for q1.31 data
+ * @param  coef: coefficients to compute
+ * @param  design: floating point coefficients
+ * @param  q: fractional bits of the coefficients (BIQUAD_Q31_COEF_Q)
+ */
+void lw_biquad_q31_coef(biquad_q31_coef_t *coef, const biquad_design_t *design,
+                        uint8_t q);
+
+/**
+ * @brief  This function initializes a q1.15 cascade with cleared states
+ * @param  bq: cascade to initialize
+ * @param  coef: array of n_sections coefficient sets, owned by the caller
+ * @param  state: array of BIQUAD_STATE_SIZE states, owned by the caller
+ * @param  n_sections: number of sections
+ * @param  shift: fractional bits of the coefficients
+ * @param  n_channels: number of channels
+ */
+void lw_biquad_q15_init(biquad_q15_t *bq, const biquad_q15_coef_t *coef,
+                        int16_t *state, uint8_t n_sections, uint8_t shift,
+                        uint16_t n_channels);
+
+/**
+ * @brief  This function filters a block of interleaved q1.15 samples. The
+ *         sums run on 64-bit accumulators and are rounded once per section.
+ * @param  bq: cascade
+ * @param  input: n_samples * n_channels input samples
+ * @param  output: n_samples * n_channels output samples, may be input
+ * @param  n_samples: number of samples per channel
+ */
+void lw_biquad_q15_process(biquad_q15_t *bq, const int16_t *input,
+                           int16_t *output, uint32_t n_samples);
+
+/**
+ * @brief  This function initializes a q1.31 cascade with cleared states
+ * @param  bq: cascade to initialize
+ * @param  coef: array of n_sections coefficient sets, owned by the caller
+ * @param  state: array of BIQUAD_STATE_SIZE states, owned by the caller
+ * @param  n_sections: number of sections
+ * @param  shift: fractional bits of the coefficients
+ * @param  n_channels: number of channels
+ */
+void lw_biquad_q31_init(biquad_q31_t *bq, const biquad_q31_coef_t *coef,
+                        int32_t *state, uint8_t n_sections, uint8_t shift,
+                        uint16_t n_channels);
+
+/**
+ * @brief  This function filters a block of interleaved q1.31 samples. The
+ *         sums run on 64-bit accumulators: with q.29 coefficients the five
+ *         products never overflow while their absolute sum stays below 8.
+ * @param  bq: cascade
+ * @param  input: n_samples * n_channels input samples
+ * @param  output: n_samples * n_channels output samples, may be input
+ * @param  n_samples: number of samples per channel
+ */
+void lw_biquad_q31_process(biquad_q31_t *bq, const int32_t *input,
+                           int32_t *output, uint32_t n_samples);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_BIQUAD_H_*/
+
+/*** End of File *************************************************************/
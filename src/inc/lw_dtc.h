@@ -0,0 +1,132 @@
+/*****************************************************************************
+ * Filename              :   lw_dtc.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_dtc.h
+ *  @brief This module declares an interface to compensate the inverter
+ *         dead time on the PWM compare values in fixed-point format
+ */
+
+#ifndef LW_DTC_H_
+#define LW_DTC_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+#include "lw_svpwm.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_dtc
+ * \brief           Dead-time compensation
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Dead-time compensator type definition
+ */
+typedef struct {
+  uint16_t period;      /**< timer period in counts */
+  int16_t dt_counts;    /**< compensation applied at full current, in counts */
+  int32_t band_gain;    /**< 2^29 / band, current to q1.15 angle scale */
+} dtc_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a dead-time compensator. Around zero
+ *         current the compensation follows sin(pi/2 * i/band), read from
+ *         the trigonometric table, and it is full for |i| >= band.
+ * @param  dtc: compensator to initialize
+ * @param  period: timer period in counts, compensated values are clipped to it
+ * @param  dt_counts: dead time plus switching delays in counts
+ * @param  band: current where the compensation reaches its full value (> 0)
+ */
+void lw_dtc_init(dtc_t *dtc, uint16_t period, int16_t dt_counts, int16_t band);
+
+/**
+ * @brief  This function compensates the compare values using phase
+ *         currents a and b (c is -a-b)
+ * @param  dtc: compensator
+ * @param  current: phase currents a and b in ab_t format, positive out of the leg
+ * @param  duty: commanded compare values in svpwm_out_t format
+ * @retval compensated compare values in svpwm_out_t format
+ */
+svpwm_out_t lw_dtc_run_ab(const dtc_t *dtc, ab_t current, svpwm_out_t duty);
+
+/**
+ * @brief  This function compensates the compare values using the current
+ *         components alpha and beta
+ * @param  dtc: compensator
+ * @param  current: current components alpha and beta in alphabeta_t format
+ * @param  duty: commanded compare values in svpwm_out_t format
+ * @retval compensated compare values in svpwm_out_t format
+ */
+svpwm_out_t lw_dtc_run_alphabeta(const dtc_t *dtc, alphabeta_t current,
+                                 svpwm_out_t duty);
+
+/**
+ * @brief  This function compensates the compare values of several
+ *         inverters using phase currents a and b
+ * @param  dtc: array of n_inverters compensators
+ * @param  current: array of n_inverters phase currents
+ * @param  duty: array of n_inverters commanded compare values
+ * @param  output: array of n_inverters compensated compare values
+ * @param  n_inverters: number of inverters
+ */
+void lw_dtc_run_ab_batch(const dtc_t *dtc, const ab_t *current,
+                         const svpwm_out_t *duty, svpwm_out_t *output,
+                         uint16_t n_inverters);
+
+/**
+ * @brief  This function compensates the compare values of several
+ *         inverters using the current components alpha and beta
+ * @param  dtc: array of n_inverters compensators
+ * @param  current: array of n_inverters current vectors
+ * @param  duty: array of n_inverters commanded compare values
+ * @param  output: array of n_inverters compensated compare values
+ * @param  n_inverters: number of inverters
+ */
+void lw_dtc_run_alphabeta_batch(const dtc_t *dtc, const alphabeta_t *current,
+                                const svpwm_out_t *duty, svpwm_out_t *output,
+                                uint16_t n_inverters);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_DTC_H_*/
+
+/*** End of File *************************************************************/
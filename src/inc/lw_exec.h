@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * Filename              :   lw_exec.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_exec.h
+ *  @brief This module declares an interface to run the transformations of
+ *         many motors on a fixed pool of POSIX threads
+ */
+
+#ifndef LW_EXEC_H_
+#define LW_EXEC_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include <pthread.h>
+#include "lw_math.h"
+#include "lw_motor_soa.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_exec
+ * \brief           Sharded multi-motor executor
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/* maximum number of threads of a pool, the calling thread included */
+#define LW_EXEC_MAX_THREADS   (64u)
+
+/* shard granularity in motors: one 64 byte cache line of int16_t */
+#define LW_EXEC_SHARD_ALIGN   (LW_MOTOR_SOA_ALIGN / 2u)
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  User stage run on each shard between Park and reverse Park (for
+ *         instance the current controllers). It must only touch the motors
+ *         [first, first + count) to keep the results independent of the
+ *         number of threads. Reverse Park reuses the cos and sin columns
+ *         filled before Park, so a change of theta by the stage takes
+ *         effect at the next tick.
+ */
+typedef void (*exec_stage_t)(motor_soa_t *motors, uint32_t first,
+                             uint32_t count, void *arg);
+
+/**
+ * @brief  Reusable barrier type definition
+ */
+typedef struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  uint32_t count;
+  uint32_t waiting;
+  uint32_t phase;
+} exec_barrier_t;
+
+struct exec_s;
+
+/**
+ * @brief  Worker thread context type definition
+ */
+typedef struct {
+  struct exec_s *exec;
+  uint32_t index;
+} exec_worker_t;
+
+/**
+ * @brief  Executor type definition
+ */
+typedef struct exec_s {
+  motor_soa_t *motors;
+  exec_stage_t stage;
+  void *stage_arg;
+  uint32_t n_threads;
+  uint32_t shard_size;
+  volatile uint32_t stop;
+  exec_barrier_t start;
+  exec_barrier_t done;
+  pthread_t threads[LW_EXEC_MAX_THREADS];
+  exec_worker_t workers[LW_EXEC_MAX_THREADS];
+} exec_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes an executor and starts n_threads - 1
+ *         worker threads; the thread calling lw_exec_tick is the last one.
+ *         Motors are split in contiguous shards whose size is a multiple of
+ *         LW_EXEC_SHARD_ALIGN.
+ * @param  exec: executor to initialize
+ * @param  motors: motor states, kept by reference; columns should be laid
+ *         out by lw_motor_soa_init so that shards never share a cache line
+ * @param  n_threads: number of threads, 1 to LW_EXEC_MAX_THREADS
+ * @param  stage: user stage between Park and reverse Park, or NULL
+ * @param  stage_arg: argument passed to the user stage
+ * @retval 0 on success, an errno value otherwise
+ */
+int lw_exec_init(exec_t *exec, motor_soa_t *motors, uint32_t n_threads,
+                 exec_stage_t stage, void *stage_arg);
+
+/**
+ * @brief  This function runs one tick on every motor: Clarke and Park of
+ *         the phase currents, the user stage, then reverse Park of the
+ *         voltage commands. It returns when all the shards are done.
+ * @param  exec: executor
+ */
+void lw_exec_tick(exec_t *exec);
+
+/**
+ * @brief  This function stops the worker threads and releases the executor
+ * @param  exec: executor
+ */
+void lw_exec_deinit(exec_t *exec);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_EXEC_H_*/
+
+/*** End of File *************************************************************/
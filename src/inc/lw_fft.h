@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * Filename              :   lw_fft.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_fft.h
+ *  @brief This module declares an interface to run in-place radix-2 FFTs on
+ *         q1.15 and q1.31 data with block floating point scaling
+ */
+
+#ifndef LW_FFT_H_
+#define LW_FFT_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_fft
+ * \brief           Fixed-point FFT
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define LW_FFT_MAX_LOG2N  16u     /**< largest transform, 65536 points */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Complex q1.15 sample
+ */
+typedef struct {
+  int16_t re;
+  int16_t im;
+} complex_q15_t;
+
+/**
+ * @brief  Complex q1.31 sample
+ */
+typedef struct {
+  int32_t re;
+  int32_t im;
+} complex_q31_t;
+
+/**
+ * @brief  Twiddle factor in q1.31 format
+ */
+typedef struct {
+  int32_t cos;
+  int32_t sin;
+} fft_twiddle_t;
+
+/**
+ * @brief  Transform direction type definition
+ */
+typedef enum {
+  FFT_FORWARD = 0,      /**< X[k] = sum of x[n] * exp(-j*2*pi*k*n/N) */
+  FFT_INVERSE           /**< x[n] = sum of X[k] * exp(+j*2*pi*k*n/N), no 1/N */
+} fft_dir_t;
+
+/**
+ * @brief  Output order type definition
+ */
+typedef enum {
+  FFT_ORDER_NATURAL = 0,  /**< natural order, one permutation pass */
+  FFT_ORDER_BITREV        /**< bit-reversed order, no permutation pass */
+} fft_order_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function returns the cosine and the sine of a phase. The
+ *         coarse angle comes from the first quadrant of the sin_cos_table
+ *         through lw_math_trig_functions (1024 steps per turn) and the
+ *         remainder is applied with a second order rotation, so no other
+ *         table is needed. The accuracy is the one of the q1.15 table.
+ * @param  phase: angle as a fraction of a turn, 2^32 = 2*pi
+ * @retval cosine and sine in q1.31 format
+ */
+fft_twiddle_t lw_fft_twiddle(uint32_t phase);
+
+/**
+ * @brief  This function runs an in-place FFT on q1.15 data. The stages are
+ *         decimation in frequency; when an input could overflow a stage,
+ *         that stage scales its inputs by 2 or 4 and the block exponent
+ *         grows accordingly. Above 1024 points the last stages run block
+ *         by block on 1024 points that stay in cache, and the blocks are
+ *         aligned to a common exponent at the end.
+ * @param  data: array of 2^log2n samples, overwritten with the transform
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ * @param  dir: transform direction
+ * @param  order: output order
+ * @param  exponent: block exponent, the transform is data * 2^exponent
+ * @retval 0 on success, EINVAL for an unsupported size
+ */
+int lw_fft_q15(complex_q15_t *data, uint8_t log2n, fft_dir_t dir,
+               fft_order_t order, int16_t *exponent);
+
+/**
+ * @brief  This function runs an in-place FFT on q1.31 data, as lw_fft_q15
+ * @param  data: array of 2^log2n samples, overwritten with the transform
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ * @param  dir: transform direction
+ * @param  order: output order
+ * @param  exponent: block exponent, the transform is data * 2^exponent
+ * @retval 0 on success, EINVAL for an unsupported size
+ */
+int lw_fft_q31(complex_q31_t *data, uint8_t log2n, fft_dir_t dir,
+               fft_order_t order, int16_t *exponent);
+
+/**
+ * @brief  This function reorders q1.15 data between natural and bit-reversed
+ *         order
+ * @param  data: array of 2^log2n samples
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ */
+void lw_fft_bitrev_q15(complex_q15_t *data, uint8_t log2n);
+
+/**
+ * @brief  This function reorders q1.31 data between natural and bit-reversed
+ *         order
+ * @param  data: array of 2^log2n samples
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ */
+void lw_fft_bitrev_q31(complex_q31_t *data, uint8_t log2n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_FFT_H_*/
+
+/*** End of File *************************************************************/
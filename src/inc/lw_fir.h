@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * Filename              :   lw_fir.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_fir.h
+ *  @brief This module declares an interface to run FIR filters on q1.15
+ *         data, with optional decimation
+ */
+
+#ifndef LW_FIR_H_
+#define LW_FIR_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_fir
+ * \brief           FIR filter
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/**
+ * @brief  Size of the delay line of a filter
+ * @param  n_taps: number of taps
+ */
+#define FIR_DELAY_SIZE(n_taps) (2u * (uint32_t)(n_taps))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  FIR filter type definition. The output is
+ *                  y[k] = sum of coef[i] * x[k - i], i = 0 .. n_taps - 1
+ *         Each sample is written twice in the delay line, n_taps apart, so
+ *         the last n_taps samples are always contiguous and the inner loop
+ *         is a plain dot product without index wrapping.
+ */
+typedef struct {
+  const int16_t *coef;  /**< n_taps coefficients in q1.15 format */
+  int16_t *delay;       /**< FIR_DELAY_SIZE delay line */
+  uint16_t n_taps;      /**< number of taps */
+  uint16_t pos;         /**< index of the newest sample */
+  uint16_t decim;       /**< decimation factor, 1 = none */
+  uint16_t phase;       /**< input samples since the last decimated output */
+} fir_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a filter with a cleared delay line
+ * @param  fir: filter to initialize
+ * @param  coef: array of n_taps coefficients in q1.15 format, owned by the
+ *         caller
+ * @param  delay: array of FIR_DELAY_SIZE samples, owned by the caller
+ * @param  n_taps: number of taps (> 0)
+ * @param  decim: decimation factor of lw_fir_decimate (> 0)
+ */
+void lw_fir_init(fir_t *fir, const int16_t *coef, int16_t *delay,
+                 uint16_t n_taps, uint16_t decim);
+
+/**
+ * @brief  This function clears the delay line of a filter
+ * @param  fir: filter
+ */
+void lw_fir_reset(fir_t *fir);
+
+/**
+ * @brief  This function filters one sample
+ * @param  fir: filter
+ * @param  input: input sample
+ * @retval output sample, rounded and saturated to [-32767, 32767]
+ */
+int16_t lw_fir_step(fir_t *fir, int16_t input);
+
+/**
+ * @brief  This function filters a block of samples
+ * @param  fir: filter
+ * @param  input: array of n input samples
+ * @param  output: array of n output samples, may be input
+ * @param  n: number of samples
+ */
+void lw_fir_process(fir_t *fir, const int16_t *input, int16_t *output,
+                    uint32_t n);
+
+/**
+ * @brief  This function filters and decimates a block of samples. Every
+ *         input enters the delay line but the dot product only runs for one
+ *         input out of decim, so the cost per input is n_taps / decim
+ *         multiply-accumulates as with a polyphase structure. The phase is
+ *         kept across blocks of any length.
+ * @param  fir: filter
+ * @param  input: array of n input samples
+ * @param  output: array of at least n / decim + 1 output samples
+ * @param  n: number of input samples
+ * @retval number of output samples written
+ */
+uint32_t lw_fir_decimate(fir_t *fir, const int16_t *input, int16_t *output,
+                         uint32_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_FIR_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,141 @@
+/*****************************************************************************
+ * Filename              :   lw_flux.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_flux.h
+ *  @brief This module declares an interface to estimate the flux linkage of
+ *         a PMSM with a voltage-model observer in fixed-point format
+ */
+
+#ifndef LW_FLUX_H_
+#define LW_FLUX_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_flux
+ * \brief           Voltage-model flux observer
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Voltage-model flux observer type definition. For each axis
+ *                  e[k]   = v[k] - R * i[k]
+ *                  dc[k]  = dc[k-1] + hp_coef * (e[k] - dc[k-1])
+ *                  psi[k] = leak * psi[k-1] + gain * (e[k] - dc[k])
+ *         The high-pass on the back-EMF removes the offsets of the voltage
+ *         and current paths, the leak bounds the drift of the integrator:
+ *         together they are a band-pass around the electrical frequency,
+ *         whose phase lead vanishes well above its corner frequencies.
+ *         gain is Ts scaled to the voltage and flux units. When l is not
+ *         zero the rotor flux psi - L * i is returned instead of the stator
+ *         flux.
+ */
+typedef struct {
+  int16_t r;            /**< stator resistance in q.r_shift format */
+  uint8_t r_shift;      /**< fractional bits of r */
+  int16_t l;            /**< stator inductance in q.l_shift format, 0 = off */
+  uint8_t l_shift;      /**< fractional bits of l */
+  int16_t gain;         /**< integrator gain in q1.15 format */
+  int16_t leak;         /**< integrator pole in q1.15 format, < 32767 */
+  int16_t hp_coef;      /**< back-EMF high-pass coefficient in q1.15 format */
+  int32_t dc_alpha;     /**< back-EMF offset alpha, upper 16 bits */
+  int32_t dc_beta;      /**< back-EMF offset beta, upper 16 bits */
+  int64_t psi_alpha;    /**< stator flux alpha, q1.15 << 16 */
+  int64_t psi_beta;     /**< stator flux beta, q1.15 << 16 */
+} flux_t;
+
+/**
+ * @brief  Flux observer output type definition
+ */
+typedef struct {
+  alphabeta_t flux;     /**< flux linkage */
+  int16_t magnitude;    /**< flux magnitude */
+  int16_t angle;        /**< flux angle in q1.15 format */
+} flux_out_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a flux observer
+ * @param  flux: observer to initialize
+ * @param  r: stator resistance in q.r_shift format
+ * @param  r_shift: fractional bits of r
+ * @param  l: stator inductance in q.l_shift format, 0 for the stator flux
+ * @param  l_shift: fractional bits of l
+ * @param  gain: integrator gain in q1.15 format
+ * @param  leak: integrator pole in q1.15 format
+ * @param  hp_coef: back-EMF high-pass coefficient in q1.15 format
+ */
+void lw_flux_init(flux_t *flux, int16_t r, uint8_t r_shift, int16_t l,
+                  uint8_t l_shift, int16_t gain, int16_t leak, int16_t hp_coef);
+
+/**
+ * @brief  This function clears the state of a flux observer
+ * @param  flux: observer
+ */
+void lw_flux_reset(flux_t *flux);
+
+/**
+ * @brief  This function runs one step of the observer
+ * @param  flux: observer
+ * @param  current: measured current in alphabeta_t format
+ * @param  voltage: applied voltage in alphabeta_t format
+ * @retval flux linkage, magnitude from lw_math_sqrt and angle from
+ *         lw_math_atan2 in the convention of lw_math_park
+ */
+flux_out_t lw_flux_step(flux_t *flux, alphabeta_t current, alphabeta_t voltage);
+
+/**
+ * @brief  This function runs the observer on a block of samples
+ * @param  flux: observer
+ * @param  current: array of n measured currents
+ * @param  voltage: array of n applied voltages
+ * @param  out: array of n outputs
+ * @param  n: number of samples
+ */
+void lw_flux_process(flux_t *flux, const alphabeta_t *current,
+                     const alphabeta_t *voltage, flux_out_t *out, uint32_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_FLUX_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,149 @@
+/*****************************************************************************
+ * Filename              :   lw_goertzel.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_goertzel.h
+ *  @brief This module declares an interface to evaluate single DFT bins of
+ *         q1.15 data with the Goertzel algorithm
+ */
+
+#ifndef LW_GOERTZEL_H_
+#define LW_GOERTZEL_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_goertzel
+ * \brief           Goertzel DFT bins
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define GOERTZEL_MAX_WINDOW   65536u  /**< longest window without overflow */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Bank of Goertzel bins stored as one array per parameter
+ *         (structure of arrays). Each bin runs
+ *                  s[k] = x[k] + 2 * cos(w) * s[k-1] - s[k-2]
+ *         with cos(w) built from lw_math_trig_functions reads. The angle is
+ *         rounded to a table step, fs / 1024, and cos(w) = 1 - 2*sin^2(w/2)
+ *         is kept in q2.30 format: a q1.15 cosine would detune a low bin by
+ *         up to 2^-16 / sin(w) rad per sample, most of a bin over a few
+ *         thousand samples. The residual tuning error, within 2^-14 rad
+ *         per sample, keeps amplitudes within 1% and phases within 0.25
+ *         rad for windows up to 8192 samples.
+ */
+typedef struct {
+  int32_t *cos;         /**< cos(w) of every bin in q2.30 format */
+  int32_t *sin;         /**< sin(w) of every bin in q2.30 format */
+  int64_t *s1;          /**< s[k-1] of every bin */
+  int64_t *s2;          /**< s[k-2] of every bin */
+  uint32_t n_bins;      /**< number of bins */
+  uint32_t count;       /**< samples in the current window */
+} goertzel_t;
+
+/**
+ * @brief  Goertzel bin output type definition. The phase is referenced to
+ *         the last sample of the window.
+ */
+typedef struct {
+  int16_t re;           /**< real part, amplitude scale */
+  int16_t im;           /**< imaginary part, amplitude scale */
+  int16_t amplitude;    /**< amplitude of the sinusoid at the bin */
+} goertzel_out_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a bank of bins, all at zero frequency
+ *         and with a cleared window
+ * @param  g: bank of bins
+ * @param  cos: array of n_bins values, owned by the caller
+ * @param  sin: array of n_bins values, owned by the caller
+ * @param  s1: array of n_bins states, owned by the caller
+ * @param  s2: array of n_bins states, owned by the caller
+ * @param  n_bins: number of bins
+ */
+void lw_goertzel_init(goertzel_t *g, int32_t *cos, int32_t *sin, int64_t *s1,
+                      int64_t *s2, uint32_t n_bins);
+
+/**
+ * @brief  This function sets the frequency of one bin
+ * @param  g: bank of bins
+ * @param  bin: bin index
+ * @param  angle: angle per sample in q1.15 format, 65536 * f / fs, rounded
+ *         to the nearest table step (a multiple of 64, fs / 1024)
+ */
+void lw_goertzel_set_bin(goertzel_t *g, uint32_t bin, int16_t angle);
+
+/**
+ * @brief  This function clears the window of every bin
+ * @param  g: bank of bins
+ */
+void lw_goertzel_reset(goertzel_t *g);
+
+/**
+ * @brief  This function feeds a block of samples to every bin. The bins
+ *         are independent, so the inner loop runs across them. The states
+ *         grow as N * A / (2 * sin(w)), and as N^2 * A / 2 at zero
+ *         frequency, so they are int64 and the window is capped at
+ *         GOERTZEL_MAX_WINDOW samples: later ones are ignored until the
+ *         next reset.
+ * @param  g: bank of bins
+ * @param  input: array of n samples
+ * @param  n: number of samples
+ */
+void lw_goertzel_process(goertzel_t *g, const int16_t *input, uint32_t n);
+
+/**
+ * @brief  This function returns the DFT of one bin over the samples fed
+ *         since the last reset, scaled so that a sinusoid of amplitude A at
+ *         the bin frequency returns A. The magnitude goes through
+ *         lw_math_sqrt.
+ * @param  g: bank of bins
+ * @param  bin: bin index
+ * @retval bin output
+ */
+goertzel_out_t lw_goertzel_get(const goertzel_t *g, uint32_t bin);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_GOERTZEL_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Filename              :   lw_lpf.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_lpf.h
+ *  @brief This module declares an interface to run banks of first-order
+ *         low-pass filters in fixed-point format
+ */
+
+#ifndef LW_LPF_H_
+#define LW_LPF_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_lpf
+ * \brief           First-order low-pass filter bank
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Bank of one-pole low-pass filters stored as one array per
+ *         parameter (structure of arrays). Each channel computes
+ *                  y[k] = y[k-1] + FMUL(x[k] - y[k-1], coef, 15)
+ *         with the same arithmetic shift as FMUL. The state is kept in the
+ *         upper 16 bits of an int32, so the truncation only affects the 16
+ *         extra fractional bits.
+ */
+typedef struct {
+  int16_t *coef;        /**< filter coefficients in q1.15 format */
+  int32_t *state;       /**< filter outputs, upper 16 bits */
+  uint32_t n;           /**< number of channels */
+} lpf_bank_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function computes the coefficient of a one-pole low-pass
+ *         filter, 1 - exp(-2*pi*fc/fs). It is meant to run offline or at
+ *         start-up.
+ * @param  fc: cut-off frequency in Hz
+ * @param  fs: sampling frequency in Hz
+ * @retval coefficient in q1.15 format
+ */
+int16_t lw_lpf_coef(double fc, double fs);
+
+/**
+ * @brief  This function initializes a bank of filters with cleared outputs
+ * @param  bank: bank of filters
+ * @param  coef: array of n coefficients in q1.15 format, owned by the caller
+ * @param  state: array of n states, owned by the caller
+ * @param  n: number of channels
+ */
+void lw_lpf_bank_init(lpf_bank_t *bank, int16_t *coef, int32_t *state,
+                      uint32_t n);
+
+/**
+ * @brief  This function sets the output of every channel of a bank
+ * @param  bank: bank of filters
+ * @param  value: array of n initial outputs, NULL to clear them
+ */
+void lw_lpf_bank_reset(lpf_bank_t *bank, const int16_t *value);
+
+/**
+ * @brief  This function runs one step of every filter of a bank. The loop
+ *         has no data dependent branches, so it vectorizes across the
+ *         channels.
+ * @param  bank: bank of filters
+ * @param  input: array of n inputs
+ * @param  output: array of n outputs
+ */
+void lw_lpf_bank_step(lpf_bank_t *bank, const int16_t *input, int16_t *output);
+
+/**
+ * @brief  This function runs one step of a single filter with the same
+ *         arithmetic as a bank channel, for filters kept inside other
+ *         modules. The state keeps 16 extra fractional bits so that small
+ *         coefficients do not stall it.
+ * @param  state: filter state, q1.15 value in the upper 16 bits
+ * @param  input: new sample in q1.15 format
+ * @param  coef: filter coefficient in q1.15 format
+ * @retval filtered sample in q1.15 format
+ */
+static inline int16_t lw_lpf_step(int32_t *state, int16_t input, int16_t coef) {
+
+  int64_t error = ((int64_t)input * 65536) - (int64_t)*state;
+
+  *state += (int32_t)((error * coef) >> 15);
+
+  return ((int16_t)(*state >> 16));
+}
+
+/**
+ * @brief  This function returns the output of one channel of a bank
+ * @param  bank: bank of filters
+ * @param  ch: channel index
+ * @retval filter output
+ */
+static inline int16_t lw_lpf_bank_get(const lpf_bank_t *bank, uint32_t ch) {
+  return ((int16_t)(bank->state[ch] >> 16));
+}
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_LPF_H_*/
+
+/*** End of File *************************************************************/
@@ -73,6 +73,15 @@ extern "C"{
  * Module Preprocessor Macros
  ******************************************************************************/
 
+/* Define LW_MATH_HEADER_ONLY before including this file (or project wide)
+ to get every function as static inline, so that the compiler can inline
+ the trigonometric lookup into the transformations at the call site */
+#ifdef LW_MATH_HEADER_ONLY
+#define LW_MATH_API static inline
+#else
+#define LW_MATH_API
+#endif
+
 /*****************************************************************************
  * Module Typedefs
  ******************************************************************************/
@@ -127,7 +136,7 @@ typedef struct {
  * @param q: q format of the fixed point number as input
  * @return integer part of the fixed-point number
  */
-int32_t lw_math_fix_2_int(fix_t f, uint32_t q);
+LW_MATH_API int32_t lw_math_fix_2_int(fix_t f, uint32_t q);
 
 /**
  * @brief This function returns the integer part of a fixed-point
@@ -137,7 +146,7 @@ int32_t lw_math_fix_2_int(fix_t f, uint32_t q);
  * @param q: q format of the fixed point number as input
  * @return integer part of the fixed-point number
  */
-int32_t lw_math_fix_2_int_round(fix_t f, uint32_t q);
+LW_MATH_API int32_t lw_math_fix_2_int_round(fix_t f, uint32_t q);
 
 /**
  * @brief This function return the fractional part of a fixed-point number
@@ -146,7 +155,7 @@ int32_t lw_math_fix_2_int_round(fix_t f, uint32_t q);
  * @param q: q format of the fixed point number as input
  * @return fractional part of the fixed-point number
  */
-fix_t lw_math_fix_fract_part(fix_t f, uint32_t q);
+LW_MATH_API fix_t lw_math_fix_fract_part(fix_t f, uint32_t q);
 
 /**
  * @brief  This function returns cosine and sine functions of the angle fed in
@@ -154,7 +163,7 @@ fix_t lw_math_fix_fract_part(fix_t f, uint32_t q);
  * @param  angle: angle in q1.15 format
  * @retval trig_components_t Cos(angle) and Sin(angle) in trig_components_t format
  */
-trig_components_t lw_math_trig_functions(int16_t angle);
+LW_MATH_API trig_components_t lw_math_trig_functions(int16_t angle);
 
 /**
  * @brief  It calculates the square root of a non-negative s32. It returns 0
@@ -162,7 +171,16 @@ trig_components_t lw_math_trig_functions(int16_t angle);
  * @param  input int32_t number
  * @retval int32_t Square root of input (0 if input < 0)
  */
-int32_t lw_math_sqrt(int32_t input);
+LW_MATH_API int32_t lw_math_sqrt(int32_t input);
+
+/**
+ * @brief  This function returns the angle of the vector (x, y), as the
+ *         standard atan2(y, x), computed with 15 CORDIC iterations
+ * @param  y: ordinate
+ * @param  x: abscissa
+ * @retval angle in q1.15 format (0 for the null vector)
+ */
+LW_MATH_API int16_t lw_math_atan2(int16_t y, int16_t x);
 
 /**
  * @brief  This function transforms components a and b (which are
@@ -173,7 +191,7 @@ int32_t lw_math_sqrt(int32_t input);
  * @param  input: component a and b in ab_t format
  * @retval Components alpha and beta in alphabeta_t format
  */
-alphabeta_t lw_math_clarke(ab_t input);
+LW_MATH_API alphabeta_t lw_math_clarke(ab_t input);
 
 /**
  * @brief  This function transforms components alpha and beta, which
@@ -185,7 +203,7 @@ alphabeta_t lw_math_clarke(ab_t input);
  * @param  theta: rotating frame angular position in q1.15 format
  * @retval Components q and d in qd_t format
  */
-qd_t lw_math_park(alphabeta_t input, int16_t theta);
+LW_MATH_API qd_t lw_math_park(alphabeta_t input, int16_t theta);
 
 /**
  * @brief  This function transforms the input component q and d, to a stationary reference
@@ -196,7 +214,96 @@ qd_t lw_math_park(alphabeta_t input, int16_t theta);
  * @param  theta: angular position in q1.15 format
  * @retval output component alpha and beta in alphabeta_t format
  */
-alphabeta_t lw_math_rev_park(qd_t input, int16_t theta);
+LW_MATH_API alphabeta_t lw_math_rev_park(qd_t input, int16_t theta);
+
+/**
+ * @brief  This function transforms components alpha and beta on several
+ *         harmonic reference frames at once. Frame k rotates at
+ *         orders[k] * theta, so the output of each frame is the same as
+ *         lw_math_park(input, orders[k] * theta) (negative orders give the
+ *         negative sequence frames).
+ * @param  input: components values alpha and beta in alphabeta_t format
+ * @param  theta: fundamental angular position in q1.15 format
+ * @param  orders: harmonic order of each frame
+ * @param  output: components q and d of each frame in qd_t format
+ * @param  n_frames: number of frames
+ */
+LW_MATH_API void lw_math_park_multi(alphabeta_t input, int16_t theta,
+                                    const int8_t *orders, qd_t *output,
+                                    uint8_t n_frames);
+
+/**
+ * @brief  This function applies lw_math_clarke to n samples stored as
+ *         separate component arrays (structure of arrays)
+ * @param  a: array of n components a
+ * @param  b: array of n components b
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_clarke_soa(const int16_t *a, const int16_t *b,
+                                    int16_t *alpha, int16_t *beta,
+                                    uint32_t n);
+
+/**
+ * @brief  This function applies lw_math_park to n samples stored as
+ *         separate component arrays (structure of arrays)
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  theta: array of n angular positions in q1.15 format
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_park_soa(const int16_t *alpha, const int16_t *beta,
+                                  const int16_t *theta, int16_t *q,
+                                  int16_t *d, uint32_t n);
+
+/**
+ * @brief  This function applies lw_math_rev_park to n samples stored as
+ *         separate component arrays (structure of arrays)
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  theta: array of n angular positions in q1.15 format
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_rev_park_soa(const int16_t *q, const int16_t *d,
+                                      const int16_t *theta, int16_t *alpha,
+                                      int16_t *beta, uint32_t n);
+
+/**
+ * @brief  This function applies lw_math_park to n samples stored as
+ *         separate component arrays, with the cosine and sine of the angles
+ *         already computed, e.g. by lw_math_trig_functions
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  cos: array of n cosines in q1.15 format
+ * @param  sin: array of n sines in q1.15 format
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_park_trig_soa(const int16_t *alpha, const int16_t *beta,
+                                       const int16_t *cos, const int16_t *sin,
+                                       int16_t *q, int16_t *d, uint32_t n);
+
+/**
+ * @brief  This function applies lw_math_rev_park to n samples stored as
+ *         separate component arrays, with the cosine and sine of the angles
+ *         already computed, e.g. by lw_math_trig_functions
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  cos: array of n cosines in q1.15 format
+ * @param  sin: array of n sines in q1.15 format
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_rev_park_trig_soa(const int16_t *q, const int16_t *d,
+                                           const int16_t *cos, const int16_t *sin,
+                                           int16_t *alpha, int16_t *beta, uint32_t n);
 
 /**
  * \}
@@ -206,6 +313,10 @@ alphabeta_t lw_math_rev_park(qd_t input, int16_t theta);
 } // extern "C"
 #endif
 
+#ifdef LW_MATH_HEADER_ONLY
+#include "lw_math_impl.h"
+#endif
+
 #endif /*LW_MATH_H_*/
 
 /*** End of File *************************************************************/
@@ -0,0 +1,262 @@
+/*****************************************************************************
+ * Filename              :   lw_math.hpp
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math.hpp
+ *  @brief This module declares constexpr C++ versions of the lw_math
+ *         functions. They use the same table and the same integer
+ *         arithmetic as the C ones, so they give identical results and can
+ *         be evaluated at compile time (C++14 or later).
+ */
+
+#ifndef LW_MATH_HPP_
+#define LW_MATH_HPP_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+#include "lw_math_table.h"
+
+#if __cplusplus < 201402L
+#error "lw_math.hpp needs C++14 constexpr"
+#endif
+
+namespace lw_math {
+
+/**
+ * \defgroup        lw_math_cpp
+ * \brief           constexpr C++ interface of lw_math
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+namespace detail {
+
+constexpr int16_t sin_cos_table[256] = LW_MATH_SIN_COS_TABLE;
+
+constexpr int16_t atan_table[LW_MATH_ATAN_TABLE_SIZE] = LW_MATH_ATAN_TABLE;
+
+/* the transformations saturate to the symmetric range [-32767, 32767] */
+constexpr int16_t sat_q15(int32_t value) {
+  return (value > INT16_MAX) ? INT16_MAX :
+         ((value < -INT16_MAX) ? static_cast<int16_t>(-INT16_MAX)
+                               : static_cast<int16_t>(value));
+}
+
+} // namespace detail
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief constexpr version of lw_math_fix_2_int
+ *
+ * @param f: fixed point number to convert
+ * @param q: q format of the fixed point number as input
+ * @return integer part of the fixed-point number
+ */
+constexpr int32_t fix_2_int(fix_t f, uint32_t q) {
+  return (f >= 0) ? static_cast<int32_t>(f / (1L << q))
+                  : static_cast<int32_t>((f - (1L << q) + 1) / (1L << q));
+}
+
+/**
+ * @brief constexpr version of lw_math_fix_2_int_round
+ *
+ * @param f: fixed point number to convert
+ * @param q: q format of the fixed point number as input
+ * @return integer part of the fixed-point number
+ */
+constexpr int32_t fix_2_int_round(fix_t f, uint32_t q) {
+  return fix_2_int(static_cast<fix_t>(f + (1L << q) / 2), q);
+}
+
+/**
+ * @brief constexpr version of lw_math_fix_fract_part
+ *
+ * @param f: fixed point number from where to extract fractional part
+ * @param q: q format of the fixed point number as input
+ * @return fractional part of the fixed-point number
+ */
+constexpr fix_t fix_fract_part(fix_t f, uint32_t q) {
+  return static_cast<fix_t>(f & ((1L << q) - 1));
+}
+
+/**
+ * @brief  constexpr version of lw_math_trig_functions
+ * @param  angle: angle in q1.15 format
+ * @retval trig_components_t Cos(angle) and Sin(angle) in trig_components_t format
+ */
+constexpr trig_components_t trig_functions(int16_t angle) {
+
+  trig_components_t local_components = {0, 0};
+  uint16_t uhindex = static_cast<uint16_t>(static_cast<uint16_t>(
+                       static_cast<int32_t>(32768) + static_cast<int32_t>(angle)) / 64u);
+  uint8_t index = static_cast<uint8_t>(uhindex);
+  uint8_t mirror = static_cast<uint8_t>(0xFFu - index);
+
+  switch (uhindex & 0x0300u) {
+    case 0x0200u: {   /* 0 to 90 degrees */
+      local_components.sin = detail::sin_cos_table[index];
+      local_components.cos = detail::sin_cos_table[mirror];
+      break;
+    }
+
+    case 0x0300u: {   /* 90 to 180 degrees */
+      local_components.sin = detail::sin_cos_table[mirror];
+      local_components.cos = static_cast<int16_t>(-detail::sin_cos_table[index]);
+      break;
+    }
+
+    case 0x0000u: {   /* 180 to 270 degrees */
+      local_components.sin = static_cast<int16_t>(-detail::sin_cos_table[index]);
+      local_components.cos = static_cast<int16_t>(-detail::sin_cos_table[mirror]);
+      break;
+    }
+
+    default: {        /* 270 to 360 degrees */
+      local_components.sin = static_cast<int16_t>(-detail::sin_cos_table[mirror]);
+      local_components.cos = detail::sin_cos_table[index];
+      break;
+    }
+  }
+
+  return (local_components);
+}
+
+/**
+ * @brief  constexpr version of lw_math_sqrt
+ * @param  input int32_t number
+ * @retval int32_t Square root of input (0 if input < 0)
+ */
+constexpr int32_t sqrt(int32_t input) {
+
+  uint8_t biter = 0u;
+  int32_t wtemproot = (input <= static_cast<int32_t>(2097152)) ? 128 : 8192;
+  int32_t wtemprootnew = 0;
+
+  if (input > 0) {
+    do {
+      wtemprootnew = (wtemproot + input / wtemproot) / 2;
+      if (wtemprootnew == wtemproot) {
+        biter = 6u;
+      }
+      else {
+        biter++;
+        wtemproot = wtemprootnew;
+      }
+    } while (biter < 6u);
+  }
+
+  return (wtemprootnew);
+}
+
+/**
+ * @brief  constexpr version of lw_math_atan2
+ * @param  y: ordinate
+ * @param  x: abscissa
+ * @retval angle in q1.15 format (0 for the null vector)
+ */
+constexpr int16_t atan2(int16_t y, int16_t x) {
+
+  int32_t wx = static_cast<int32_t>(x) * 16384;
+  int32_t wy = static_cast<int32_t>(y) * 16384;
+  int32_t wxnew = 0;
+  uint16_t angle = 0u;
+
+  if (wx < 0) {
+    wx = -wx;
+    wy = -wy;
+    angle = 32768u;
+  }
+
+  for (uint8_t i = 0u; i < static_cast<uint8_t>(LW_MATH_ATAN_TABLE_SIZE); i++) {
+    if (wy > 0) {
+      wxnew = wx + (wy >> i);
+      wy = wy - (wx >> i);
+      angle = static_cast<uint16_t>(angle + static_cast<uint16_t>(detail::atan_table[i]));
+    }
+    else {
+      wxnew = wx - (wy >> i);
+      wy = wy + (wx >> i);
+      angle = static_cast<uint16_t>(angle - static_cast<uint16_t>(detail::atan_table[i]));
+    }
+    wx = wxnew;
+  }
+
+  return ((0 == x) && (0 == y)) ? static_cast<int16_t>(0) : static_cast<int16_t>(angle);
+}
+
+/**
+ * @brief  constexpr version of lw_math_clarke
+ * @param  input: component a and b in ab_t format
+ * @retval Components alpha and beta in alphabeta_t format
+ */
+constexpr alphabeta_t clarke(ab_t input) {
+
+  alphabeta_t output = {input.a, 0};
+
+  output.beta = detail::sat_q15((-(0x49E6 * static_cast<int32_t>(input.a)) -
+                                 (2 * 0x49E6 * static_cast<int32_t>(input.b))) / 32768);
+
+  return (output);
+}
+
+/**
+ * @brief  constexpr version of lw_math_park
+ * @param  input: components values alpha and beta in alphabeta_t format
+ * @param  theta: rotating frame angular position in q1.15 format
+ * @retval Components q and d in qd_t format
+ */
+constexpr qd_t park(alphabeta_t input, int16_t theta) {
+
+  trig_components_t trig = trig_functions(theta);
+  qd_t output = {0, 0};
+
+  output.q = detail::sat_q15(((input.alpha * static_cast<int32_t>(trig.cos)) -
+                              (input.beta * static_cast<int32_t>(trig.sin))) / 32768);
+  output.d = detail::sat_q15(((input.alpha * static_cast<int32_t>(trig.sin)) +
+                              (input.beta * static_cast<int32_t>(trig.cos))) / 32768);
+
+  return (output);
+}
+
+/**
+ * @brief  constexpr version of lw_math_rev_park
+ * @param  input: input component q and d in qd_t format
+ * @param  theta: angular position in q1.15 format
+ * @retval output component alpha and beta in alphabeta_t format
+ */
+constexpr alphabeta_t rev_park(qd_t input, int16_t theta) {
+
+  trig_components_t trig = trig_functions(theta);
+  alphabeta_t output = {0, 0};
+
+  output.alpha = detail::sat_q15(((input.q * static_cast<int32_t>(trig.cos)) +
+                                  (input.d * static_cast<int32_t>(trig.sin))) / 32768);
+  output.beta = detail::sat_q15(((input.d * static_cast<int32_t>(trig.cos)) -
+                                 (input.q * static_cast<int32_t>(trig.sin))) / 32768);
+
+  return (output);
+}
+
+/**
+ * \}
+ */
+
+} // namespace lw_math
+
+#endif /*LW_MATH_HPP_*/
+
+/*** End of File *************************************************************/
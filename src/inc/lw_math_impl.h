@@ -0,0 +1,644 @@
+/*****************************************************************************
+ * Filename              :   lw_math_impl.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_impl.h
+ *  @brief This file holds the definitions of the lw_math functions. It is
+ *         compiled once by lw_math.c, or included by lw_math.h in every
+ *         translation unit when LW_MATH_HEADER_ONLY is defined, so that
+ *         the functions and the table become static inline there.
+ */
+
+#ifndef LW_MATH_IMPL_H_
+#define LW_MATH_IMPL_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_math.h"
+#include "lw_math_table.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define SIN_MASK        0x0300u
+#define U0_90           0x0200u
+#define U90_180         0x0300u
+#define U180_270        0x0000u
+#define U270_360        0x0100u
+
+#define divSQRT_3 (int32_t)0x49E6    /* 1/sqrt(3) in q1.15 format=0.5773315*/
+
+#define PARK_MULTI_CHUNK  (8u)        /* frames processed for each trig pass */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static inline int16_t lw_math_sat_q15(int32_t value);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const int16_t sin_cos_table[256] = LW_MATH_SIN_COS_TABLE;
+
+static const int16_t atan_table[LW_MATH_ATAN_TABLE_SIZE] = LW_MATH_ATAN_TABLE;
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief This function return the integer part of a fixed-point number
+ *
+ * @param f: fixed point number to convert
+ * @param q: q format of the fixed point number as input
+ * @return integer part of the fixed-point number
+ */
+LW_MATH_API int32_t lw_math_fix_2_int(fix_t f, uint32_t q) {
+
+  if (f >= 0) {
+      return (int32_t)(f / (1L << q));
+  } else {
+      return (int32_t)((f - (1L << q) + 1) / (1L << q));
+  }
+}
+
+/**
+ * @brief This function returns the integer part of a fixed-point
+ *        number rounded of the nearest integer
+ *
+ * @param f: fixed point number to convert
+ * @param q: q format of the fixed point number as input
+ * @return integer part of the fixed-point number
+ */
+LW_MATH_API int32_t lw_math_fix_2_int_round(fix_t f, uint32_t q) {
+  return lw_math_fix_2_int(f + (1L << q) / 2, q);
+}
+
+/**
+ * @brief This function return the fractional part of a fixed-point number
+ *
+ * @param f: fixed point number from where to extract fractional part
+ * @param q: q format of the fixed point number as input
+ * @return fractional part of the fixed-point number
+ */
+LW_MATH_API fix_t lw_math_fix_fract_part(fix_t f, uint32_t q) {
+  return f & ((1L << q) - 1);
+}
+
+/**
+ * @brief  This function returns cosine and sine functions of the angle fed in
+ *         input
+ * @param  angle: angle in q1.15 format
+ * @retval trig_components_t Cos(angle) and Sin(angle) in trig_components_t format
+ */
+LW_MATH_API trig_components_t lw_math_trig_functions(int16_t angle) {
+
+  int32_t shindex;
+  uint16_t uhindex;
+
+  trig_components_t local_components;
+
+  /* 10 bit index computation  */
+  shindex = ((int32_t)32768 + (int32_t)angle);
+  uhindex = (uint16_t)shindex;
+  uhindex /= (uint16_t)64;
+
+  switch((uint16_t)(uhindex) & SIN_MASK) {
+    case U0_90: {
+      local_components.sin = sin_cos_table[(uint8_t)(uhindex)];
+      local_components.cos = sin_cos_table[(uint8_t)(0xFFu - (uint8_t)(uhindex))];
+      break;
+    }
+
+    case U90_180: {
+      local_components.sin = sin_cos_table[(uint8_t)(0xFFu - (uint8_t)(uhindex))];
+      local_components.cos = -sin_cos_table[(uint8_t)(uhindex)];
+      break;
+    }
+
+    case U180_270: {
+      local_components.sin = -sin_cos_table[(uint8_t)(uhindex)];
+      local_components.cos = -sin_cos_table[(uint8_t)(0xFFu - (uint8_t)(uhindex))];
+      break;
+    }
+
+    case U270_360: {
+      local_components.sin = -sin_cos_table[(uint8_t)(0xFFu - (uint8_t)(uhindex))];
+      local_components.cos = sin_cos_table[(uint8_t)(uhindex)];
+      break;
+    }
+
+    default: {
+      break;
+    }
+  }
+
+  return (local_components);
+}
+
+/**
+ * @brief  It calculates the square root of a non-negative s32. It returns 0
+ *         for negative s32.
+ * @param  input int32_t number
+ * @retval int32_t Square root of input (0 if input < 0)
+ */
+LW_MATH_API int32_t lw_math_sqrt(int32_t input) {
+
+  uint8_t biter = 0u;
+  int32_t wtemproot;
+  int32_t wtemprootnew;
+
+  if(input > 0) {
+
+    if(input <= (int32_t)2097152) {
+      wtemproot = (int32_t)128;
+    }
+    else {
+      wtemproot = (int32_t)8192;
+    }
+
+    do {
+      wtemprootnew = (wtemproot + input / wtemproot) / (int32_t)2;
+      if(wtemprootnew == wtemproot) {
+        biter = 6u;
+      }
+      else {
+        biter++;
+        wtemproot = wtemprootnew;
+      }
+    }while (biter < 6u);
+  }
+  else {
+    wtemprootnew = (int32_t)0;
+  }
+
+  return (wtemprootnew);
+}
+
+/**
+ * @brief  This function returns the angle of the vector (x, y), as the
+ *         standard atan2(y, x), computed with 15 CORDIC iterations
+ * @param  y: ordinate
+ * @param  x: abscissa
+ * @retval angle in q1.15 format (0 for the null vector)
+ */
+LW_MATH_API int16_t lw_math_atan2(int16_t y, int16_t x) {
+
+  int32_t wx = (int32_t)x * 16384;
+  int32_t wy = (int32_t)y * 16384;
+  int32_t wxnew;
+  uint16_t angle = 0u;
+  uint8_t i;
+
+  /* bring the vector in the right half plane, the angle wraps on 16 bit */
+  if (wx < 0) {
+    wx = -wx;
+    wy = -wy;
+    angle = 32768u;
+  }
+
+  /* rotate towards the x axis, the CORDIC gain does not affect the angle */
+  for (i = 0u; i < (uint8_t)LW_MATH_ATAN_TABLE_SIZE; i++) {
+    if (wy > 0) {
+      wxnew = wx + (wy >> i);
+      wy = wy - (wx >> i);
+      angle = (uint16_t)(angle + (uint16_t)atan_table[i]);
+    }
+    else {
+      wxnew = wx - (wy >> i);
+      wy = wy + (wx >> i);
+      angle = (uint16_t)(angle - (uint16_t)atan_table[i]);
+    }
+    wx = wxnew;
+  }
+
+  if ((0 == x) && (0 == y)) {
+    angle = 0u;
+  }
+
+  return ((int16_t)angle);
+}
+
+/**
+  * @brief  This function transforms components a and b (which are
+  *         directed along axes each displaced by 120 degrees) into components
+  *         alpha and beta.
+  *                               alpha = Ia
+  *                       beta = -(2 * Ib + Ia) / sqrt(3)
+  * @param  input: component a and b in ab_t format
+  * @retval Components alpha and beta in alphabeta_t format
+  */
+LW_MATH_API alphabeta_t lw_math_clarke(ab_t input) {
+
+  alphabeta_t output;
+
+  int32_t a_divSQRT3_tmp;
+  int32_t b_divSQRT3_tmp;
+  int32_t wbeta_tmp;
+  int16_t hbeta_tmp;
+
+  /* qIalpha = qIas*/
+  output.alpha = input.a;
+
+  a_divSQRT3_tmp = divSQRT_3 * ((int32_t)input.a);
+
+  b_divSQRT3_tmp = divSQRT_3 * ((int32_t)input.b);
+
+  /*qIbeta = -(2*qIbs+qIas)/sqrt(3)*/
+
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  /*wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) >> 15;*/
+
+  wbeta_tmp = (-(a_divSQRT3_tmp) - (b_divSQRT3_tmp) - (b_divSQRT3_tmp)) / 32768;
+
+
+  /* Check saturation of Ibeta */
+  if (wbeta_tmp > INT16_MAX)
+  {
+    hbeta_tmp = INT16_MAX;
+  }
+  else if (wbeta_tmp < (-32768))
+  {
+    hbeta_tmp =  ((int16_t)-32768);
+  }
+  else
+  {
+    hbeta_tmp = ((int16_t)wbeta_tmp);
+  }
+
+  output.beta = hbeta_tmp;
+
+  if (((int16_t )-32768) == output.beta)
+  {
+    output.beta = -32767;
+  }
+
+  return (output);
+}
+
+/**
+  * @brief  This function transforms components alpha and beta, which
+  *         belong to a stationary qd reference frame, to a rotor flux
+  *         synchronous reference frame (properly oriented), so as q and d.
+  *                   d= alpha *sin(theta) + beta * cos(theta)
+  *                   q= alpha *cos(theta) - beta * sin(theta)
+  * @param  input: components values alpha and beta in alphabeta_t format
+  * @param  theta: rotating frame angular position in q1.15 format
+  * @retval Components q and d in qd_t format
+  */
+LW_MATH_API qd_t lw_math_park(alphabeta_t input, int16_t theta) {
+
+  qd_t output;
+  int32_t d_tmp_1;
+  int32_t d_tmp_2;
+  int32_t q_tmp_1;
+  int32_t q_tmp_2;
+  int32_t wqd_tmp;
+  int16_t hqd_tmp;
+  trig_components_t Local_Vector_Components;
+
+  Local_Vector_Components = lw_math_trig_functions(theta);
+
+  /*No overflow guaranteed*/
+  q_tmp_1 = input.alpha * ((int32_t )Local_Vector_Components.cos);
+
+  /*No overflow guaranteed*/
+  q_tmp_2 = input.beta * ((int32_t)Local_Vector_Components.sin);
+
+  /*Iq component in Q1.15 Format */
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  /*wqd_tmp = (q_tmp_1 - q_tmp_2) >> 15;  */
+
+  wqd_tmp = (q_tmp_1 - q_tmp_2) / 32768;
+
+  /* Check saturation of Iq */
+  if (wqd_tmp > INT16_MAX)
+  {
+    hqd_tmp = INT16_MAX;
+  }
+  else if (wqd_tmp < (-32768))
+  {
+    hqd_tmp = ((int16_t)-32768);
+  }
+  else
+  {
+    hqd_tmp = ((int16_t)wqd_tmp);
+  }
+
+  output.q = hqd_tmp;
+
+  if (((int16_t )-32768) == output.q)
+  {
+    output.q = -32767;
+  }
+
+  /*No overflow guaranteed*/
+  d_tmp_1 = input.alpha * ((int32_t )Local_Vector_Components.sin);
+
+  /*No overflow guaranteed*/
+  d_tmp_2 = input.beta * ((int32_t )Local_Vector_Components.cos);
+
+  /*Id component in Q1.15 Format */
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  /* wqd_tmp = (d_tmp_1 + d_tmp_2) >> 15; */
+
+  wqd_tmp = (d_tmp_1 + d_tmp_2) / 32768;
+
+  /* Check saturation of Id */
+  if (wqd_tmp > INT16_MAX)
+  {
+    hqd_tmp = INT16_MAX;
+  }
+  else if (wqd_tmp < (-32768))
+  {
+    hqd_tmp = ((int16_t)-32768);
+  }
+  else
+  {
+    hqd_tmp = ((int16_t)wqd_tmp);
+  }
+
+  output.d = hqd_tmp;
+
+  if (((int16_t)-32768) == output.d)
+  {
+    output.d = -32767;
+  }
+
+  return (output);
+}
+
+/**
+  * @brief  This function transforms the input component q and d, to a stationary reference
+  *         frame, so as to obtain alpha and beta:
+  *                  alfa= q * cos(theta)+ d * sin(theta)
+  *                  beta= -q * sin(theta)+ d * cos(theta)
+  * @param  input: input component q and d in qd_t format
+  * @param  theta: angular position in q1.15 format
+  * @retval output component alpha and beta in alphabeta_t format
+  */
+LW_MATH_API alphabeta_t lw_math_rev_park(qd_t input, int16_t theta) {
+
+  int32_t alpha_tmp1;
+  int32_t alpha_tmp2;
+  int32_t beta_tmp1;
+  int32_t beta_tmp2;
+  trig_components_t Local_Vector_Components;
+  alphabeta_t output;
+
+  Local_Vector_Components = lw_math_trig_functions(theta);
+
+  /*No overflow guaranteed*/
+  alpha_tmp1 = input.q * ((int32_t)Local_Vector_Components.cos);
+  alpha_tmp2 = input.d * ((int32_t)Local_Vector_Components.sin);
+
+
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+    that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+    the compiler to perform the shift (instead of LSR logical shift right) */
+
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  /*output.alpha = (int16_t)(((alpha_tmp1) + (alpha_tmp2)) >> 15);*/
+
+  /* saturated as in lw_math_park: a vector beyond full scale would wrap */
+  output.alpha = lw_math_sat_q15(((alpha_tmp1) + (alpha_tmp2)) / 32768);
+
+
+  beta_tmp1 = input.q * ((int32_t)Local_Vector_Components.sin);
+  beta_tmp2 = input.d * ((int32_t)Local_Vector_Components.cos);
+
+  /* WARNING: the below instruction is not MISRA compliant, user should verify
+  that Cortex-M3 assembly instruction ASR (arithmetic shift right) is used by
+  the compiler to perform the shift (instead of LSR logical shift right) */
+  //cstat !MISRAC2012-Rule-1.3_n !ATH-shift-neg !MISRAC2012-Rule-10.1_R6
+  /*output.beta = (int16_t)((beta_tmp2 - beta_tmp1) >> 15);*/
+
+  output.beta = lw_math_sat_q15((beta_tmp2 - beta_tmp1) / 32768);
+
+
+  return (output);
+}
+
+/**
+ * @brief  This function transforms components alpha and beta on several
+ *         harmonic reference frames at once. Frame k rotates at
+ *         orders[k] * theta, so the output of each frame is the same as
+ *         lw_math_park(input, orders[k] * theta) (negative orders give the
+ *         negative sequence frames).
+ * @param  input: components values alpha and beta in alphabeta_t format
+ * @param  theta: fundamental angular position in q1.15 format
+ * @param  orders: harmonic order of each frame
+ * @param  output: components q and d of each frame in qd_t format
+ * @param  n_frames: number of frames
+ */
+LW_MATH_API void lw_math_park_multi(alphabeta_t input, int16_t theta,
+                                    const int8_t *orders, qd_t *output,
+                                    uint8_t n_frames) {
+
+  int16_t cos_k[PARK_MULTI_CHUNK];
+  int16_t sin_k[PARK_MULTI_CHUNK];
+  trig_components_t Local_Vector_Components;
+  uint8_t base;
+  uint8_t count;
+  uint8_t k;
+
+  for (base = 0u; base < n_frames; base += count) {
+
+    count = (uint8_t)(n_frames - base);
+    if (count > PARK_MULTI_CHUNK) {
+      count = PARK_MULTI_CHUNK;
+    }
+
+    /* q1.15 angles wrap on 16 bit, so k*theta is the k-th harmonic angle;
+     * the product is unsigned 32 bit, uint16_t operands would be promoted
+     * to int and overflow for negative orders */
+    for (k = 0u; k < count; k++) {
+      Local_Vector_Components = lw_math_trig_functions(
+          (int16_t)(uint16_t)((uint32_t)(uint16_t)orders[base + k] * (uint16_t)theta));
+      cos_k[k] = Local_Vector_Components.cos;
+      sin_k[k] = Local_Vector_Components.sin;
+    }
+
+    /* same arithmetic as lw_math_park, laid out across the frames */
+    for (k = 0u; k < count; k++) {
+      output[base + k].q = lw_math_sat_q15(
+          ((input.alpha * (int32_t)cos_k[k]) - (input.beta * (int32_t)sin_k[k])) / 32768);
+      output[base + k].d = lw_math_sat_q15(
+          ((input.alpha * (int32_t)sin_k[k]) + (input.beta * (int32_t)cos_k[k])) / 32768);
+    }
+  }
+}
+
+/**
+ * @brief  This function applies lw_math_clarke to n samples stored as
+ *         separate component arrays (structure of arrays)
+ * @param  a: array of n components a
+ * @param  b: array of n components b
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_clarke_soa(const int16_t *a, const int16_t *b,
+                                    int16_t *alpha, int16_t *beta,
+                                    uint32_t n) {
+
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    alpha[i] = a[i];
+    beta[i] = lw_math_sat_q15((-(divSQRT_3 * (int32_t)a[i]) -
+                               (2 * divSQRT_3 * (int32_t)b[i])) / 32768);
+  }
+}
+
+/**
+ * @brief  This function applies lw_math_park to n samples stored as
+ *         separate component arrays (structure of arrays)
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  theta: array of n angular positions in q1.15 format
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_park_soa(const int16_t *alpha, const int16_t *beta,
+                                  const int16_t *theta, int16_t *q,
+                                  int16_t *d, uint32_t n) {
+
+  uint32_t i;
+  trig_components_t Local_Vector_Components;
+
+  for (i = 0u; i < n; i++) {
+    Local_Vector_Components = lw_math_trig_functions(theta[i]);
+    q[i] = lw_math_sat_q15(((alpha[i] * (int32_t)Local_Vector_Components.cos) -
+                            (beta[i] * (int32_t)Local_Vector_Components.sin)) / 32768);
+    d[i] = lw_math_sat_q15(((alpha[i] * (int32_t)Local_Vector_Components.sin) +
+                            (beta[i] * (int32_t)Local_Vector_Components.cos)) / 32768);
+  }
+}
+
+/**
+ * @brief  This function applies lw_math_rev_park to n samples stored as
+ *         separate component arrays (structure of arrays)
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  theta: array of n angular positions in q1.15 format
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_rev_park_soa(const int16_t *q, const int16_t *d,
+                                      const int16_t *theta, int16_t *alpha,
+                                      int16_t *beta, uint32_t n) {
+
+  uint32_t i;
+  trig_components_t Local_Vector_Components;
+
+  for (i = 0u; i < n; i++) {
+    Local_Vector_Components = lw_math_trig_functions(theta[i]);
+    alpha[i] = lw_math_sat_q15(((q[i] * (int32_t)Local_Vector_Components.cos) +
+                                (d[i] * (int32_t)Local_Vector_Components.sin)) / 32768);
+    beta[i] = lw_math_sat_q15(((d[i] * (int32_t)Local_Vector_Components.cos) -
+                               (q[i] * (int32_t)Local_Vector_Components.sin)) / 32768);
+  }
+}
+
+/**
+ * @brief  This function applies lw_math_park to n samples stored as
+ *         separate component arrays, with the cosine and sine of the angles
+ *         already computed, e.g. by lw_math_trig_functions
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  cos: array of n cosines in q1.15 format
+ * @param  sin: array of n sines in q1.15 format
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_park_trig_soa(const int16_t *alpha, const int16_t *beta,
+                                       const int16_t *cos, const int16_t *sin,
+                                       int16_t *q, int16_t *d, uint32_t n) {
+
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    q[i] = lw_math_sat_q15(((alpha[i] * (int32_t)cos[i]) - (beta[i] * (int32_t)sin[i])) / 32768);
+    d[i] = lw_math_sat_q15(((alpha[i] * (int32_t)sin[i]) + (beta[i] * (int32_t)cos[i])) / 32768);
+  }
+}
+
+/**
+ * @brief  This function applies lw_math_rev_park to n samples stored as
+ *         separate component arrays, with the cosine and sine of the angles
+ *         already computed, e.g. by lw_math_trig_functions
+ * @param  q: array of n components q
+ * @param  d: array of n components d
+ * @param  cos: array of n cosines in q1.15 format
+ * @param  sin: array of n sines in q1.15 format
+ * @param  alpha: array of n components alpha
+ * @param  beta: array of n components beta
+ * @param  n: number of samples
+ */
+LW_MATH_API void lw_math_rev_park_trig_soa(const int16_t *q, const int16_t *d,
+                                           const int16_t *cos, const int16_t *sin,
+                                           int16_t *alpha, int16_t *beta, uint32_t n) {
+
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    alpha[i] = lw_math_sat_q15(((q[i] * (int32_t)cos[i]) + (d[i] * (int32_t)sin[i])) / 32768);
+    beta[i] = lw_math_sat_q15(((d[i] * (int32_t)cos[i]) - (q[i] * (int32_t)sin[i])) / 32768);
+  }
+}
+
+/**
+ * @brief  Saturates a q1.15 result to the symmetric range [-32767, 32767]
+ *         as done by the transforms
+ * @param  value: result to saturate
+ * @retval saturated value
+ */
+static inline int16_t lw_math_sat_q15(int32_t value) {
+  return (value > INT16_MAX) ? INT16_MAX :
+         ((value < -INT16_MAX) ? (int16_t)-INT16_MAX : (int16_t)value);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
+
+/* keep the private constants out of the including translation units */
+#undef SIN_MASK
+#undef U0_90
+#undef U90_180
+#undef U180_270
+#undef U270_360
+#undef divSQRT_3
+#undef PARK_MULTI_CHUNK
+
+#endif /*LW_MATH_IMPL_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,288 @@
+/*****************************************************************************
+ * Filename              :   lw_math_ref.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_ref.h
+ *  @brief This module declares double precision reference models of the
+ *         lw_math functions and a differential checker that compares any
+ *         fixed-point implementation against them
+ */
+
+#ifndef LW_MATH_REF_H_
+#define LW_MATH_REF_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_math_ref
+ * \brief           Reference models and differential checker
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Reference cos, sin type definition (q1.15 scale, not rounded)
+ */
+typedef struct {
+  double cos;
+  double sin;
+} trig_components_ref_t;
+
+/**
+ * @brief  Reference alpha, beta type definition (q1.15 scale, not rounded)
+ */
+typedef struct {
+  double alpha;
+  double beta;
+} alphabeta_ref_t;
+
+/**
+ * @brief  Reference q, d type definition (q1.15 scale, not rounded)
+ */
+typedef struct {
+  double q;
+  double d;
+} qd_ref_t;
+
+/**
+ * @brief  Error statistics of an implementation against its reference.
+ *         Errors are in LSB, implementation minus reference; functions with
+ *         two outputs count each component as a sample.
+ */
+typedef struct {
+  uint32_t n;               /**< compared samples */
+  double max_abs_err;       /**< largest absolute error */
+  double mean_err;          /**< mean error (bias) */
+  double mean_abs_err;      /**< mean absolute error */
+  double rms_err;           /**< root mean square error */
+  int32_t worst_input[3];   /**< inputs giving the largest error */
+} ref_stats_t;
+
+/**
+ * @brief  Implementation prototypes accepted by the checker
+ */
+typedef trig_components_t (*trig_fn_t)(int16_t angle);
+typedef int32_t (*sqrt_fn_t)(int32_t input);
+typedef int16_t (*atan2_fn_t)(int16_t y, int16_t x);
+typedef alphabeta_t (*clarke_fn_t)(ab_t input);
+typedef qd_t (*park_fn_t)(alphabeta_t input, int16_t theta);
+typedef alphabeta_t (*rev_park_fn_t)(qd_t input, int16_t theta);
+typedef void (*park_multi_fn_t)(alphabeta_t input, int16_t theta,
+                                const int8_t *orders, qd_t *output,
+                                uint8_t n_frames);
+typedef void (*clarke_soa_fn_t)(const int16_t *a, const int16_t *b,
+                                int16_t *alpha, int16_t *beta, uint32_t n);
+typedef void (*park_soa_fn_t)(const int16_t *alpha, const int16_t *beta,
+                              const int16_t *theta, int16_t *q, int16_t *d,
+                              uint32_t n);
+typedef void (*rev_park_soa_fn_t)(const int16_t *q, const int16_t *d,
+                                  const int16_t *theta, int16_t *alpha,
+                                  int16_t *beta, uint32_t n);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  Reference of lw_math_trig_functions: 32768*cos, 32768*sin of
+ *         angle*pi/32768, limited to 32767
+ * @param  angle: angle in q1.15 format
+ * @retval Cos(angle) and Sin(angle) in trig_components_ref_t format
+ */
+trig_components_ref_t lw_math_ref_trig_functions(int16_t angle);
+
+/**
+ * @brief  Reference of lw_math_sqrt
+ * @param  input: int32_t number
+ * @retval Square root of input (0 if input < 0)
+ */
+double lw_math_ref_sqrt(int32_t input);
+
+/**
+ * @brief  Reference of lw_math_atan2: 32768*atan2(y, x)/pi
+ * @param  y: ordinate
+ * @param  x: abscissa
+ * @retval angle in q1.15 scale (0 for the null vector)
+ */
+double lw_math_ref_atan2(int16_t y, int16_t x);
+
+/**
+ * @brief  Reference of lw_math_clarke, saturated to [-32767, 32767]
+ * @param  input: component a and b in ab_t format
+ * @retval Components alpha and beta in alphabeta_ref_t format
+ */
+alphabeta_ref_t lw_math_ref_clarke(ab_t input);
+
+/**
+ * @brief  Reference of lw_math_park, saturated to [-32767, 32767]
+ * @param  input: components values alpha and beta in alphabeta_t format
+ * @param  theta: rotating frame angular position in q1.15 format
+ * @retval Components q and d in qd_ref_t format
+ */
+qd_ref_t lw_math_ref_park(alphabeta_t input, int16_t theta);
+
+/**
+ * @brief  Reference of lw_math_rev_park, saturated to [-32767, 32767]
+ * @param  input: input component q and d in qd_t format
+ * @param  theta: angular position in q1.15 format
+ * @retval output component alpha and beta in alphabeta_ref_t format
+ */
+alphabeta_ref_t lw_math_ref_rev_park(qd_t input, int16_t theta);
+
+/**
+ * @brief  This function checks a trigonometric implementation on every
+ *         one of the 65536 angles
+ * @param  fn: implementation under test
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_trig(trig_fn_t fn, ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a square root implementation on the edge
+ *         cases (zero, negatives, perfect squares and their neighbours,
+ *         INT32_MAX) and on n_random random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_sqrt(sqrt_fn_t fn, uint32_t n_random, uint32_t seed,
+                            ref_stats_t *stats);
+
+/**
+ * @brief  This function checks an arctangent implementation on the edge
+ *         cases (every pair of full scale, zero and unit values) and on
+ *         n_random random inputs. Angle errors are wrapped to [-32768, 32768).
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_atan2(atan2_fn_t fn, uint32_t n_random, uint32_t seed,
+                             ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a Clarke implementation on the edge cases
+ *         (every pair of full scale, zero and unit values) and on n_random
+ *         random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_clarke(clarke_fn_t fn, uint32_t n_random, uint32_t seed,
+                              ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a Park implementation on the edge cases
+ *         (full scale, zero and unit values on the quadrant boundaries) and
+ *         on n_random random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_park(park_fn_t fn, uint32_t n_random, uint32_t seed,
+                            ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a reverse Park implementation on the edge
+ *         cases (full scale, zero and unit values on the quadrant
+ *         boundaries) and on n_random random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_rev_park(rev_park_fn_t fn, uint32_t n_random,
+                                uint32_t seed, ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a multi-frame Park implementation on the
+ *         Park edge cases and on n_random random inputs, each on frames of
+ *         order 1, -1, 2, -2, 5, -5, 7, 11, 13, 127 and -128. Frame k is
+ *         compared with the Park reference at the wrapped angle
+ *         orders[k] * theta.
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_park_multi(park_multi_fn_t fn, uint32_t n_random,
+                                  uint32_t seed, ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a structure of arrays Clarke implementation
+ *         on the Clarke edge cases and on n_random random inputs, fed in
+ *         blocks of 256 samples
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_clarke_soa(clarke_soa_fn_t fn, uint32_t n_random,
+                                  uint32_t seed, ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a structure of arrays Park implementation
+ *         on the Park edge cases and on n_random random inputs, fed in
+ *         blocks of 256 samples
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_park_soa(park_soa_fn_t fn, uint32_t n_random,
+                                uint32_t seed, ref_stats_t *stats);
+
+/**
+ * @brief  This function checks a structure of arrays reverse Park
+ *         implementation on the reverse Park edge cases and on n_random
+ *         random inputs, fed in blocks of 256 samples
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_rev_park_soa(rev_park_soa_fn_t fn, uint32_t n_random,
+                                    uint32_t seed, ref_stats_t *stats);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_MATH_REF_H_*/
+
+/*** End of File *************************************************************/
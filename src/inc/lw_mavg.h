@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * Filename              :   lw_mavg.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_mavg.h
+ *  @brief This module declares an interface to compute moving averages and
+ *         moving RMS values of many channels with O(1) updates
+ */
+
+#ifndef LW_MAVG_H_
+#define LW_MAVG_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_mavg
+ * \brief           Moving average and moving RMS
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Moving average of n q1.15 channels over len samples. The history
+ *         is stored sample by sample as arrays of n values (hist[slot * n +
+ *         ch]) and each update adds the new sample and subtracts the oldest
+ *         one from an integer sum, so the sum never drifts. Until len
+ *         samples are in, the missing ones count as zero.
+ */
+typedef struct {
+  int16_t *hist;        /**< len * n past samples */
+  int32_t *sum;         /**< n sums of the window */
+  uint16_t len;         /**< window length (<= 65535) */
+  uint16_t pos;         /**< slot of the oldest sample */
+  uint32_t n;           /**< number of channels */
+} mavg_t;
+
+/**
+ * @brief  Moving RMS of n q1.15 channels over len samples, with the same
+ *         layout as mavg_t and integer sums of the squares in q2.30 format
+ */
+typedef struct {
+  int16_t *hist;        /**< len * n past samples */
+  int64_t *sum_sq;      /**< n sums of the squares of the window */
+  uint16_t len;         /**< window length */
+  uint16_t pos;         /**< slot of the oldest sample */
+  uint32_t n;           /**< number of channels */
+} mrms_t;
+
+/**
+ * @brief  Moving average of n fix_t channels over len samples
+ */
+typedef struct {
+  fix_t *hist;          /**< len * n past samples */
+  int64_t *sum;         /**< n sums of the window */
+  uint16_t len;         /**< window length */
+  uint16_t pos;         /**< slot of the oldest sample */
+  uint32_t n;           /**< number of channels */
+} mavg_fix_t;
+
+/**
+ * @brief  Moving RMS of n fix_t channels over len samples, in the q format
+ *         of the samples whatever it is. The squares are shifted right by
+ *         ceil(log2(len)) bits before the sum,
+ *         just the headroom the sum needs, and always in the same way, so
+ *         adding and removing a sample still cancel exactly.
+ */
+typedef struct {
+  fix_t *hist;          /**< len * n past samples */
+  int64_t *sum_sq;      /**< n sums of the squares shifted right by shift */
+  uint16_t len;         /**< window length */
+  uint16_t pos;         /**< slot of the oldest sample */
+  uint8_t shift;        /**< shift of the squares, ceil(log2(len)) */
+  uint32_t n;           /**< number of channels */
+} mrms_fix_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a moving average with a cleared window
+ * @param  mavg: moving average to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mavg_init(mavg_t *mavg, int16_t *hist, int32_t *sum, uint16_t len,
+                  uint32_t n);
+
+/**
+ * @brief  This function pushes one sample per channel in the window. The
+ *         loop has no data dependent branches and vectorizes across the
+ *         channels.
+ * @param  mavg: moving average
+ * @param  input: array of n samples
+ */
+void lw_mavg_update(mavg_t *mavg, const int16_t *input);
+
+/**
+ * @brief  This function returns the average of one channel
+ * @param  mavg: moving average
+ * @param  ch: channel index
+ * @retval average of the window, truncated toward zero
+ */
+int16_t lw_mavg_get(const mavg_t *mavg, uint32_t ch);
+
+/**
+ * @brief  This function initializes a moving RMS with a cleared window
+ * @param  mrms: moving RMS to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum_sq: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mrms_init(mrms_t *mrms, int16_t *hist, int64_t *sum_sq, uint16_t len,
+                  uint32_t n);
+
+/**
+ * @brief  This function pushes one sample per channel in the window
+ * @param  mrms: moving RMS
+ * @param  input: array of n samples
+ */
+void lw_mrms_update(mrms_t *mrms, const int16_t *input);
+
+/**
+ * @brief  This function returns the RMS value of one channel. The square
+ *         root (lw_math_sqrt) only runs here, not in the update.
+ * @param  mrms: moving RMS
+ * @param  ch: channel index
+ * @retval RMS value of the window in q1.15 format
+ */
+int16_t lw_mrms_get(const mrms_t *mrms, uint32_t ch);
+
+/**
+ * @brief  This function initializes a fix_t moving average with a cleared
+ *         window
+ * @param  mavg: moving average to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mavg_fix_init(mavg_fix_t *mavg, fix_t *hist, int64_t *sum, uint16_t len,
+                      uint32_t n);
+
+/**
+ * @brief  This function pushes one sample per channel in the window
+ * @param  mavg: moving average
+ * @param  input: array of n samples
+ */
+void lw_mavg_fix_update(mavg_fix_t *mavg, const fix_t *input);
+
+/**
+ * @brief  This function returns the average of one channel
+ * @param  mavg: moving average
+ * @param  ch: channel index
+ * @retval average of the window, truncated toward zero
+ */
+fix_t lw_mavg_fix_get(const mavg_fix_t *mavg, uint32_t ch);
+
+/**
+ * @brief  This function initializes a fix_t moving RMS with a cleared window
+ * @param  mrms: moving RMS to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum_sq: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mrms_fix_init(mrms_fix_t *mrms, fix_t *hist, int64_t *sum_sq,
+                      uint16_t len, uint32_t n);
+
+/**
+ * @brief  This function pushes one sample per channel in the window. The
+ *         sum of squares fits an int64 for any input.
+ * @param  mrms: moving RMS
+ * @param  input: array of n samples in q format
+ */
+void lw_mrms_fix_update(mrms_fix_t *mrms, const fix_t *input);
+
+/**
+ * @brief  This function returns the RMS value of one channel with
+ *         lw_math_sqrt. Mean squares too large for its int32 input are
+ *         scaled down by powers of 4 first, losing the same number of low
+ *         bits of the result.
+ * @param  mrms: moving RMS
+ * @param  ch: channel index
+ * @retval RMS value of the window in q format
+ */
+fix_t lw_mrms_fix_get(const mrms_fix_t *mrms, uint32_t ch);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_MAVG_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,258 @@
+/*****************************************************************************
+ * Filename              :   lw_motor_soa.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_motor_soa.h
+ *  @brief This module declares a container of motor states stored as cache
+ *         aligned component arrays (structure of arrays), so that the batch
+ *         lw_math kernels work on it directly
+ */
+
+#ifndef LW_MOTOR_SOA_H_
+#define LW_MOTOR_SOA_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_motor_soa
+ * \brief           Structure of arrays motor state container
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/* column alignment in bytes */
+#define LW_MOTOR_SOA_ALIGN     (64u)
+
+/* number of columns of the container */
+#define LW_MOTOR_SOA_COLUMNS   (13u)
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/* column length of n motors, padded to whole cache lines of int16_t */
+#define LW_MOTOR_SOA_STRIDE(n) \
+  ((((uint32_t)(n)) + ((LW_MOTOR_SOA_ALIGN / 2u) - 1u)) & ~((LW_MOTOR_SOA_ALIGN / 2u) - 1u))
+
+/* bytes of memory needed by n motors, alignment slack included */
+#define LW_MOTOR_SOA_MEM_SIZE(n) \
+  (((size_t)LW_MOTOR_SOA_COLUMNS * LW_MOTOR_SOA_STRIDE(n) * sizeof(int16_t)) + \
+   LW_MOTOR_SOA_ALIGN)
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Motor states stored as one array per component. Columns set up
+ *         by lw_motor_soa_init start on a 64 byte boundary and are padded
+ *         to stride elements, so that every kernel can run over whole cache
+ *         lines and threads working on separate lines never share one.
+ */
+typedef struct {
+  int16_t *i_a;         /**< phase current a */
+  int16_t *i_b;         /**< phase current b */
+  int16_t *theta;       /**< electrical angle in q1.15 format */
+  int16_t *cos;         /**< cosine of theta */
+  int16_t *sin;         /**< sine of theta */
+  int16_t *i_alpha;     /**< current alpha */
+  int16_t *i_beta;      /**< current beta */
+  int16_t *i_q;         /**< current q */
+  int16_t *i_d;         /**< current d */
+  int16_t *v_q;         /**< voltage command q */
+  int16_t *v_d;         /**< voltage command d */
+  int16_t *v_alpha;     /**< voltage command alpha */
+  int16_t *v_beta;      /**< voltage command beta */
+  uint32_t n;           /**< number of motors */
+  uint32_t stride;      /**< allocated column length */
+} motor_soa_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function lays the columns of n motors out in the memory
+ *         provided and clears them
+ * @param  motors: container to initialize
+ * @param  mem: memory of at least LW_MOTOR_SOA_MEM_SIZE(n) bytes, any alignment
+ * @param  size: size of mem in bytes
+ * @param  n: number of motors
+ * @retval 0 on success, EINVAL if the memory is too small
+ */
+int lw_motor_soa_init(motor_soa_t *motors, void *mem, size_t size, uint32_t n);
+
+/**
+ * @brief  This function fills the cos and sin columns from theta
+ * @param  motors: container
+ * @param  first: first motor
+ * @param  count: number of motors
+ */
+void lw_motor_soa_update_trig(motor_soa_t *motors, uint32_t first, uint32_t count);
+
+/**
+ * @brief  This function copies phase currents into the container
+ * @param  motors: container
+ * @param  src: array of count phase currents in ab_t format
+ * @param  index: motor of each element of src, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_gather_i_ab(motor_soa_t *motors, const ab_t *src,
+                              const uint32_t *index, uint32_t count);
+
+/**
+ * @brief  This function copies voltage commands into the container
+ * @param  motors: container
+ * @param  src: array of count voltage commands in qd_t format
+ * @param  index: motor of each element of src, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_gather_v_qd(motor_soa_t *motors, const qd_t *src,
+                              const uint32_t *index, uint32_t count);
+
+/**
+ * @brief  This function copies currents alpha and beta out of the container
+ * @param  motors: container
+ * @param  dst: array of count currents in alphabeta_t format
+ * @param  index: motor of each element of dst, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_scatter_i_alphabeta(const motor_soa_t *motors, alphabeta_t *dst,
+                                      const uint32_t *index, uint32_t count);
+
+/**
+ * @brief  This function copies currents q and d out of the container
+ * @param  motors: container
+ * @param  dst: array of count currents in qd_t format
+ * @param  index: motor of each element of dst, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_scatter_i_qd(const motor_soa_t *motors, qd_t *dst,
+                               const uint32_t *index, uint32_t count);
+
+/**
+ * @brief  This function copies voltage commands alpha and beta out of the
+ *         container
+ * @param  motors: container
+ * @param  dst: array of count voltages in alphabeta_t format
+ * @param  index: motor of each element of dst, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_scatter_v_alphabeta(const motor_soa_t *motors, alphabeta_t *dst,
+                                      const uint32_t *index, uint32_t count);
+
+/*****************************************************************************
+ * Inline accessors
+ ******************************************************************************/
+
+/**
+ * @brief  Phase currents of motor i in ab_t format
+ */
+static inline ab_t lw_motor_soa_get_i_ab(const motor_soa_t *motors, uint32_t i) {
+  ab_t out;
+  out.a = motors->i_a[i];
+  out.b = motors->i_b[i];
+  return (out);
+}
+
+/**
+ * @brief  Sets the phase currents of motor i
+ */
+static inline void lw_motor_soa_set_i_ab(motor_soa_t *motors, uint32_t i, ab_t value) {
+  motors->i_a[i] = value.a;
+  motors->i_b[i] = value.b;
+}
+
+/**
+ * @brief  Currents alpha and beta of motor i in alphabeta_t format
+ */
+static inline alphabeta_t lw_motor_soa_get_i_alphabeta(const motor_soa_t *motors,
+                                                       uint32_t i) {
+  alphabeta_t out;
+  out.alpha = motors->i_alpha[i];
+  out.beta = motors->i_beta[i];
+  return (out);
+}
+
+/**
+ * @brief  Currents q and d of motor i in qd_t format
+ */
+static inline qd_t lw_motor_soa_get_i_qd(const motor_soa_t *motors, uint32_t i) {
+  qd_t out;
+  out.q = motors->i_q[i];
+  out.d = motors->i_d[i];
+  return (out);
+}
+
+/**
+ * @brief  Voltage commands q and d of motor i in qd_t format
+ */
+static inline qd_t lw_motor_soa_get_v_qd(const motor_soa_t *motors, uint32_t i) {
+  qd_t out;
+  out.q = motors->v_q[i];
+  out.d = motors->v_d[i];
+  return (out);
+}
+
+/**
+ * @brief  Sets the voltage commands q and d of motor i
+ */
+static inline void lw_motor_soa_set_v_qd(motor_soa_t *motors, uint32_t i, qd_t value) {
+  motors->v_q[i] = value.q;
+  motors->v_d[i] = value.d;
+}
+
+/**
+ * @brief  Voltage commands alpha and beta of motor i in alphabeta_t format
+ */
+static inline alphabeta_t lw_motor_soa_get_v_alphabeta(const motor_soa_t *motors,
+                                                       uint32_t i) {
+  alphabeta_t out;
+  out.alpha = motors->v_alpha[i];
+  out.beta = motors->v_beta[i];
+  return (out);
+}
+
+/**
+ * @brief  Cosine and sine of motor i in trig_components_t format
+ */
+static inline trig_components_t lw_motor_soa_get_trig(const motor_soa_t *motors,
+                                                      uint32_t i) {
+  trig_components_t out;
+  out.cos = motors->cos[i];
+  out.sin = motors->sin[i];
+  return (out);
+}
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_MOTOR_SOA_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,170 @@
+/*****************************************************************************
+ * Filename              :   lw_pi.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pi.h
+ *  @brief This module declares an interface to run proportional-integral
+ *         controllers in fixed-point format
+ */
+
+#ifndef LW_PI_H_
+#define LW_PI_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_pi
+ * \brief           PI controller
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Anti-windup strategy type definition
+ */
+typedef enum {
+  PI_AW_CLAMP = 0,      /**< integral term kept within the output limits */
+  PI_AW_BACK_CALC       /**< saturation excess, up to the output span, fed
+                             back to the integrator; the integral term is
+                             kept within the output limits widened by the
+                             output span on each side */
+} pi_aw_t;
+
+/**
+ * @brief  PI controller type definition. The output is
+ *         (kp * e) >> kp_shift + (sum of ki * e) >> ki_shift
+ */
+typedef struct {
+  int16_t kp;           /**< proportional gain in q.kp_shift format */
+  int16_t ki;           /**< integral gain in q.ki_shift format */
+  int16_t kb;           /**< back-calculation gain in q1.15 format */
+  uint8_t kp_shift;     /**< fractional bits of kp */
+  uint8_t ki_shift;     /**< fractional bits of ki and of the integrator */
+  int16_t out_min;      /**< lower output limit */
+  int16_t out_max;      /**< upper output limit */
+  pi_aw_t aw;           /**< anti-windup strategy */
+  int64_t integral;     /**< integrator in q.ki_shift format */
+} pi_t;
+
+/**
+ * @brief  Bank of PI controllers stored as one array per parameter
+ *         (structure of arrays), all with clamping anti-windup and the same
+ *         gain formats
+ */
+typedef struct {
+  int16_t *kp;          /**< proportional gains in q.kp_shift format */
+  int16_t *ki;          /**< integral gains in q.ki_shift format */
+  int16_t *out_min;     /**< lower output limits */
+  int16_t *out_max;     /**< upper output limits */
+  int64_t *integral;    /**< integrators in q.ki_shift format */
+  uint8_t kp_shift;     /**< fractional bits of kp */
+  uint8_t ki_shift;     /**< fractional bits of ki and of the integrators */
+  uint32_t n;           /**< number of controllers */
+} pi_bank_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a PI controller with clamping
+ *         anti-windup and a cleared integrator
+ * @param  pi: controller to initialize
+ * @param  kp: proportional gain in q.kp_shift format
+ * @param  kp_shift: fractional bits of kp (0 to 15)
+ * @param  ki: integral gain in q.ki_shift format
+ * @param  ki_shift: fractional bits of ki (0 to 30)
+ * @param  out_min: lower output limit
+ * @param  out_max: upper output limit
+ */
+void lw_pi_init(pi_t *pi, int16_t kp, uint8_t kp_shift, int16_t ki,
+                uint8_t ki_shift, int16_t out_min, int16_t out_max);
+
+/**
+ * @brief  This function selects back-calculation anti-windup
+ * @param  pi: controller
+ * @param  kb: back-calculation gain in q1.15 format, usually ki/kp scaled
+ */
+void lw_pi_set_back_calc(pi_t *pi, int16_t kb);
+
+/**
+ * @brief  This function presets the integral term, for instance to start
+ *         from a known output
+ * @param  pi: controller
+ * @param  value: integral term in output units
+ */
+void lw_pi_set_integral(pi_t *pi, int16_t value);
+
+/**
+ * @brief  This function runs one step of a PI controller
+ * @param  pi: controller
+ * @param  error: reference minus feedback
+ * @retval controller output within [out_min, out_max]
+ */
+int16_t lw_pi_step(pi_t *pi, int16_t error);
+
+/**
+ * @brief  This function runs the q and d current controllers
+ * @param  pi_q: q axis controller
+ * @param  pi_d: d axis controller
+ * @param  ref: references in qd_t format
+ * @param  meas: feedbacks in qd_t format
+ * @retval controller outputs in qd_t format
+ */
+qd_t lw_pi_step_qd(pi_t *pi_q, pi_t *pi_d, qd_t ref, qd_t meas);
+
+/**
+ * @brief  This function clears the integrators of a bank
+ * @param  bank: bank of controllers, arrays already assigned
+ */
+void lw_pi_bank_reset(pi_bank_t *bank);
+
+/**
+ * @brief  This function runs one step of every controller of a bank. The
+ *         loop has no data dependent branches, so it vectorizes across the
+ *         controllers.
+ * @param  bank: bank of controllers
+ * @param  error: array of n errors
+ * @param  output: array of n outputs
+ */
+void lw_pi_bank_step(pi_bank_t *bank, const int16_t *error, int16_t *output);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_PI_H_*/
+
+/*** End of File *************************************************************/
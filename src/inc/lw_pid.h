@@ -0,0 +1,203 @@
+/*****************************************************************************
+ * Filename              :   lw_pid.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pid.h
+ *  @brief This module declares an interface to run PID controllers with
+ *         filtered derivative, setpoint weighting and bumpless transfer in
+ *         fixed-point format
+ */
+
+#ifndef LW_PID_H_
+#define LW_PID_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_pid
+ * \brief           PID controller
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  PID coefficients type definition, all in the q format of the
+ *         controller. With sample time Ts and derivative filter time Tf:
+ *                     u = kp * (b*r - y) + I + D
+ *                     I = I + ki * (r - y)
+ *                     D = ad * D + bd * ((c*r - y) - previous (c*r - y))
+ */
+typedef struct {
+  fix_t kp;             /**< proportional gain Kp */
+  fix_t ki;             /**< integral gain per sample Ki*Ts */
+  fix_t ad;             /**< derivative pole Tf/(Tf+Ts) */
+  fix_t bd;             /**< derivative gain Kd/(Tf+Ts) */
+  fix_t b;              /**< setpoint weight of the proportional term */
+  fix_t c;              /**< setpoint weight of the derivative term */
+} pid_coef_t;
+
+/**
+ * @brief  PID controller type definition
+ */
+typedef struct {
+  pid_coef_t coef;      /**< coefficients */
+  uint32_t q;           /**< q format of coefficients and signals */
+  fix_t out_min;        /**< lower output limit */
+  fix_t out_max;        /**< upper output limit */
+  fix_t integral;       /**< integral term */
+  fix_t deriv;          /**< filtered derivative term */
+  fix_t prev_ed;        /**< previous derivative error */
+  uint8_t manual;       /**< 1 when the output follows the manual value */
+  fix_t u_manual;       /**< manual output */
+} pid_ctrl_t;
+
+/**
+ * @brief  Bank of PID controllers stored as one array per parameter
+ *         (structure of arrays), all in the same q format
+ */
+typedef struct {
+  fix_t *kp;            /**< proportional gains */
+  fix_t *ki;            /**< integral gains per sample */
+  fix_t *ad;            /**< derivative poles */
+  fix_t *bd;            /**< derivative gains */
+  fix_t *b;             /**< proportional setpoint weights */
+  fix_t *c;             /**< derivative setpoint weights */
+  fix_t *out_min;       /**< lower output limits */
+  fix_t *out_max;       /**< upper output limits */
+  fix_t *integral;      /**< integral terms */
+  fix_t *deriv;         /**< filtered derivative terms */
+  fix_t *prev_ed;       /**< previous derivative errors */
+  uint8_t *manual;      /**< 1 when the output follows the manual value */
+  fix_t *u_manual;      /**< manual outputs */
+  uint32_t q;           /**< q format of coefficients and signals */
+  uint32_t n;           /**< number of controllers */
+} pid_bank_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function computes the coefficients of a PID from its
+ *         continuous time gains. It is meant to run offline or at start-up,
+ *         the update path only uses the precomputed values.
+ * @param  coef: coefficients to compute
+ * @param  kp: proportional gain
+ * @param  ki: integral gain in 1/s
+ * @param  kd: derivative gain in s
+ * @param  tf: derivative filter time constant in s
+ * @param  ts: sample time in s
+ * @param  b: setpoint weight of the proportional term (usually 0 to 1)
+ * @param  c: setpoint weight of the derivative term (usually 0)
+ * @param  q: q format of the coefficients
+ */
+void lw_pid_design(pid_coef_t *coef, double kp, double ki, double kd, double tf,
+                   double ts, double b, double c, uint32_t q);
+
+/**
+ * @brief  This function initializes a PID controller in automatic mode
+ * @param  pid: controller to initialize
+ * @param  coef: coefficients in q format
+ * @param  q: q format of coefficients and signals
+ * @param  out_min: lower output limit in q format
+ * @param  out_max: upper output limit in q format
+ */
+void lw_pid_init(pid_ctrl_t *pid, const pid_coef_t *coef, uint32_t q, fix_t out_min,
+                 fix_t out_max);
+
+/**
+ * @brief  This function switches a controller to manual mode; the output
+ *         follows u_manual and the integral term tracks it, so that the
+ *         return to automatic mode is bumpless
+ * @param  pid: controller
+ * @param  u_manual: manual output in q format
+ */
+void lw_pid_set_manual(pid_ctrl_t *pid, fix_t u_manual);
+
+/**
+ * @brief  This function switches a controller back to automatic mode
+ * @param  pid: controller
+ */
+void lw_pid_set_auto(pid_ctrl_t *pid);
+
+/**
+ * @brief  This function runs one step of a PID controller
+ * @param  pid: controller
+ * @param  ref: reference in q format
+ * @param  meas: feedback in q format
+ * @retval controller output within [out_min, out_max]
+ */
+fix_t lw_pid_step(pid_ctrl_t *pid, fix_t ref, fix_t meas);
+
+/**
+ * @brief  This function initializes every controller of a bank in automatic
+ *         mode with the same coefficients and limits and cleared states;
+ *         single controllers can be retuned in the arrays afterwards
+ * @param  bank: bank of controllers, arrays and n already assigned
+ * @param  coef: coefficients in q format
+ * @param  q: q format of coefficients and signals
+ * @param  out_min: lower output limit in q format
+ * @param  out_max: upper output limit in q format
+ */
+void lw_pid_bank_init(pid_bank_t *bank, const pid_coef_t *coef, uint32_t q,
+                      fix_t out_min, fix_t out_max);
+
+/**
+ * @brief  This function clears the integral terms, the filtered derivative
+ *         terms and the previous derivative errors of a bank; coefficients,
+ *         limits and modes are kept
+ * @param  bank: bank of controllers, arrays already assigned
+ */
+void lw_pid_bank_reset(pid_bank_t *bank);
+
+/**
+ * @brief  This function runs one step of every controller of a bank, with
+ *         the same arithmetic as lw_pid_step. Mode selection is branchless,
+ *         so the loop vectorizes across the controllers.
+ * @param  bank: bank of controllers
+ * @param  ref: array of n references
+ * @param  meas: array of n feedbacks
+ * @param  output: array of n outputs
+ */
+void lw_pid_bank_step(pid_bank_t *bank, const fix_t *ref, const fix_t *meas,
+                      fix_t *output);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_PID_H_*/
+
+/*** End of File *************************************************************/
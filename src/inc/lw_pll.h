@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * Filename              :   lw_pll.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pll.h
+ *  @brief This module declares an interface to track the angle and speed
+ *         of a rotating alpha-beta vector with a phase locked loop in
+ *         fixed-point format
+ */
+
+#ifndef LW_PLL_H_
+#define LW_PLL_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+#include "lw_pi.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_pll
+ * \brief           Angle and speed phase locked loop
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Phase locked loop type definition. The phase detector is the d
+ *         component of lw_math_park at the estimated angle, the loop filter
+ *         a PI whose output is the speed, and the speed is integrated in a
+ *         32 bit phase accumulator (one turn is 2^32).
+ */
+typedef struct {
+  pi_t pi;              /**< loop filter, output is the speed */
+  uint32_t phase;       /**< phase accumulator, angle in the upper 16 bits */
+  int16_t theta;        /**< estimated angle in q1.15 format */
+  int16_t speed;        /**< estimated speed, see speed_shift */
+  uint8_t speed_shift;  /**< speed is the angle step per sample in q1.15 LSB << speed_shift */
+} pll_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a phase locked loop. Loop gains scale
+ *         with the amplitude of the input vector.
+ * @param  pll: loop to initialize
+ * @param  kp: proportional gain in q.kp_shift format
+ * @param  kp_shift: fractional bits of kp
+ * @param  ki: integral gain in q.ki_shift format
+ * @param  ki_shift: fractional bits of ki
+ * @param  speed_max: speed limit, same unit as the speed output
+ * @param  speed_shift: fractional bits of the speed in angle LSB per sample
+ *         (0 to 16); 4 gives 1/16 LSB resolution up to 2048 LSB per sample
+ */
+void lw_pll_init(pll_t *pll, int16_t kp, uint8_t kp_shift, int16_t ki,
+                 uint8_t ki_shift, int16_t speed_max, uint8_t speed_shift);
+
+/**
+ * @brief  This function presets the angle and the speed of a loop
+ * @param  pll: loop
+ * @param  theta: angle in q1.15 format
+ * @param  speed: speed, same unit as the speed output
+ */
+void lw_pll_reset(pll_t *pll, int16_t theta, int16_t speed);
+
+/**
+ * @brief  This function runs one step of the loop. The estimated angle
+ *         locks on the input vector, so that lw_math_park(input, theta)
+ *         has its whole amplitude on q.
+ * @param  pll: loop
+ * @param  input: components alpha and beta in alphabeta_t format
+ * @retval estimated angle for the next sample in q1.15 format
+ */
+int16_t lw_pll_step(pll_t *pll, alphabeta_t input);
+
+/**
+ * @brief  This function runs one step of several loops, one for each motor
+ * @param  pll: array of n loops
+ * @param  input: array of n alpha-beta vectors
+ * @param  n: number of loops
+ */
+void lw_pll_step_batch(pll_t *pll, const alphabeta_t *input, uint16_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_PLL_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,148 @@
+/*****************************************************************************
+ * Filename              :   lw_ramp.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_ramp.h
+ *  @brief This module declares an interface to a bank of ramp generators
+ *         and slew-rate limiters
+ */
+
+#ifndef LW_RAMP_H_
+#define LW_RAMP_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_ramp
+ * \brief           Ramp generator and slew-rate limiter bank
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Bank of ramp generators stored as one array per parameter
+ *         (structure of arrays). Values and increments are in q2.30 format,
+ *         a q1.15 reference shifted by 15, so the distance to the target
+ *         always fits an int32. An axis with accel = 0 is a slew-rate
+ *         limiter, moving by at most rate per step. Otherwise the speed
+ *         changes by at most accel per step and is limited to rate, with
+ *         braking started so that the ramp stops on the target: an
+ *         acceleration-limited (trapezoidal speed) profile that starts and
+ *         stops without a speed step and does not overshoot a fixed
+ *         target. A target moved inside the braking distance is passed,
+ *         then reached again after braking at accel: the speed never
+ *         changes by more than accel. The jerk is not limited. A step has
+ *         no division.
+ */
+typedef struct {
+  int32_t *rate;        /**< largest speed, q2.30 per step */
+  int32_t *accel;       /**< largest speed change, q2.30 per step, 0 = linear */
+  int32_t *value;       /**< ramp outputs in q2.30 format */
+  int32_t *speed;       /**< ramp speeds, q2.30 per step */
+  uint32_t n;           /**< number of axes */
+} ramp_bank_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function converts a slope to an increment per step. It is
+ *         meant to run offline or at start-up.
+ * @param  slope: slope in full scale per second (per second^2 for an
+ *         acceleration, with fs squared)
+ * @param  fs: step frequency in Hz
+ * @retval increment per step in q2.30 format, in [1, 2^30 - 1]
+ */
+int32_t lw_ramp_rate(double slope, double fs);
+
+/**
+ * @brief  This function initializes a bank of ramps with cleared outputs
+ *         and linear ramps of null rate
+ * @param  bank: bank of ramps
+ * @param  rate: array of n rates, owned by the caller
+ * @param  accel: array of n accelerations, owned by the caller
+ * @param  value: array of n outputs, owned by the caller
+ * @param  speed: array of n speeds, owned by the caller
+ * @param  n: number of axes
+ */
+void lw_ramp_bank_init(ramp_bank_t *bank, int32_t *rate, int32_t *accel,
+                       int32_t *value, int32_t *speed, uint32_t n);
+
+/**
+ * @brief  This function configures one axis of a bank
+ * @param  bank: bank of ramps
+ * @param  axis: axis index
+ * @param  rate: largest speed from lw_ramp_rate
+ * @param  accel: largest speed change from lw_ramp_rate, 0 for a linear
+ *         ramp, limited to rate
+ */
+void lw_ramp_bank_set(ramp_bank_t *bank, uint32_t axis, int32_t rate,
+                      int32_t accel);
+
+/**
+ * @brief  This function sets the output of every axis of a bank and stops
+ *         them
+ * @param  bank: bank of ramps
+ * @param  value: array of n initial outputs, NULL to clear them
+ */
+void lw_ramp_bank_reset(ramp_bank_t *bank, const int16_t *value);
+
+/**
+ * @brief  This function runs one step of every ramp of a bank. The loop
+ *         has no data dependent branches, so it vectorizes across the axes.
+ * @param  bank: bank of ramps
+ * @param  target: array of n targets
+ * @param  output: array of n outputs
+ */
+void lw_ramp_bank_step(ramp_bank_t *bank, const int16_t *target,
+                       int16_t *output);
+
+/**
+ * @brief  This function returns the output of one axis of a bank
+ * @param  bank: bank of ramps
+ * @param  axis: axis index
+ * @retval ramp output
+ */
+static inline int16_t lw_ramp_bank_get(const ramp_bank_t *bank, uint32_t axis) {
+  return ((int16_t)((bank->value[axis] + 16384) >> 15));
+}
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_RAMP_H_*/
+
+/*** End of File *************************************************************/
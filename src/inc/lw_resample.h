@@ -0,0 +1,151 @@
+/*****************************************************************************
+ * Filename              :   lw_resample.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_resample.h
+ *  @brief This module declares an interface to a polyphase sample-rate
+ *         converter with rational ratio for q1.15 signals
+ */
+
+#ifndef LW_RESAMPLE_H_
+#define LW_RESAMPLE_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_resample
+ * \brief           Polyphase sample-rate converter
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/**
+ * @brief  Size of the coefficient array of a converter
+ * @param  up: interpolation factor
+ * @param  n_taps: taps per phase
+ */
+#define RESAMPLE_COEF_SIZE(up, n_taps) ((uint32_t)(up) * (uint32_t)(n_taps))
+
+/**
+ * @brief  Size of the delay line of a converter
+ * @param  n_taps: taps per phase
+ */
+#define RESAMPLE_DELAY_SIZE(n_taps) (2u * (uint32_t)(n_taps))
+
+/**
+ * @brief  Largest number of outputs produced by a block of inputs
+ * @param  n: number of input samples
+ * @param  up: interpolation factor
+ * @param  down: decimation factor
+ */
+#define RESAMPLE_OUT_SIZE(n, up, down) \
+  ((((uint32_t)(n) * (uint32_t)(up)) / (uint32_t)(down)) + 1u)
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Sample-rate converter type definition. The rate changes by
+ *         up / down: the input is conceptually upsampled by up, filtered by a
+ *         prototype low-pass h of up * n_taps taps and decimated by down.
+ *         Only the phase of h that lands on an output is evaluated,
+ *                  y = sum of h[phase + up * j] * x[newest - j]
+ *         so each output costs n_taps multiply-accumulates whatever the
+ *         ratio. The coefficients are stored phase by phase and the delay
+ *         line is written twice as in lw_fir, so every output is a
+ *         contiguous dot product.
+ */
+typedef struct {
+  const int16_t *coef;  /**< RESAMPLE_COEF_SIZE coefficients, q1.15 */
+  int16_t *delay;       /**< RESAMPLE_DELAY_SIZE delay line */
+  uint16_t up;          /**< interpolation factor */
+  uint16_t down;        /**< decimation factor */
+  uint16_t n_taps;      /**< taps per phase */
+  uint16_t pos;         /**< index of the newest sample */
+  uint16_t phase;       /**< phase of the next output, in 1 / up inputs */
+} resample_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function designs the prototype filter of a converter, a
+ *         Blackman windowed sinc cut at the lower of the two Nyquist
+ *         frequencies with a gain of up, and stores it phase by phase
+ * @param  coef: array of RESAMPLE_COEF_SIZE coefficients in q1.15 format
+ * @param  up: interpolation factor (> 0)
+ * @param  down: decimation factor (> 0)
+ * @param  n_taps: taps per phase (> 0)
+ */
+void lw_resample_design(int16_t *coef, uint16_t up, uint16_t down,
+                        uint16_t n_taps);
+
+/**
+ * @brief  This function initializes a converter with a cleared delay line.
+ *         up and down should be reduced by their common divisor.
+ * @param  rs: converter to initialize
+ * @param  coef: array of RESAMPLE_COEF_SIZE coefficients stored phase by
+ *         phase, e.g. from lw_resample_design, owned by the caller
+ * @param  delay: array of RESAMPLE_DELAY_SIZE samples, owned by the caller
+ * @param  up: interpolation factor (> 0)
+ * @param  down: decimation factor (> 0)
+ * @param  n_taps: taps per phase (> 0)
+ */
+void lw_resample_init(resample_t *rs, const int16_t *coef, int16_t *delay,
+                      uint16_t up, uint16_t down, uint16_t n_taps);
+
+/**
+ * @brief  This function clears the delay line of a converter
+ * @param  rs: converter
+ */
+void lw_resample_reset(resample_t *rs);
+
+/**
+ * @brief  This function converts a block of samples. The phase and the
+ *         delay line are kept across blocks of any length, so a stream cut
+ *         in blocks gives the same output as a single pass.
+ * @param  rs: converter
+ * @param  input: array of n input samples
+ * @param  output: array of RESAMPLE_OUT_SIZE(n, up, down) output samples
+ * @param  n: number of input samples
+ * @retval number of output samples written
+ */
+uint32_t lw_resample_process(resample_t *rs, const int16_t *input,
+                             int16_t *output, uint32_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_RESAMPLE_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ * Filename              :   lw_rfft.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_rfft.h
+ *  @brief This module declares an interface to compute spectra of real
+ *         q1.15 signals: windowing, real FFT and power spectrum
+ */
+
+#ifndef LW_RFFT_H_
+#define LW_RFFT_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_fft.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_rfft
+ * \brief           Real FFT and power spectrum
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Window type definition, periodic (DFT-even) windows
+ */
+typedef enum {
+  RFFT_WINDOW_HANN = 0,   /**< 0.5 - 0.5 cos(2*pi*n/N) */
+  RFFT_WINDOW_BLACKMAN    /**< 0.42 - 0.5 cos(2*pi*n/N) + 0.08 cos(4*pi*n/N) */
+} rfft_window_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function fills a window table in q1.15 format, with the
+ *         cosines of lw_fft_twiddle so no floating point is needed
+ * @param  window: array of n coefficients
+ * @param  n: window length
+ * @param  type: window type
+ */
+void lw_rfft_window_init(int16_t *window, uint32_t n, rfft_window_t type);
+
+/**
+ * @brief  This function multiplies a block of samples by a window
+ * @param  window: array of n coefficients in q1.15 format
+ * @param  input: array of n samples
+ * @param  output: array of n windowed samples, may be input
+ * @param  n: number of samples
+ */
+void lw_rfft_window_apply(const int16_t *window, const int16_t *input,
+                          int16_t *output, uint32_t n);
+
+/**
+ * @brief  This function computes the spectrum of a real signal with a
+ *         complex FFT of half the size: the even and odd samples are packed
+ *         as real and imaginary parts, transformed by lw_fft_q15 and
+ *         separated by the split step, which may add up to 2 bits to the
+ *         block exponent.
+ * @param  input: array of 2^log2n real samples
+ * @param  output: array of 2^(log2n - 1) + 1 bins, from DC to fs/2
+ * @param  log2n: base 2 logarithm of the size, 2 to LW_FFT_MAX_LOG2N + 1
+ * @param  exponent: block exponent, the spectrum is output * 2^exponent
+ * @retval 0 on success, EINVAL for an unsupported size
+ */
+int lw_rfft_q15(const int16_t *input, complex_q15_t *output, uint8_t log2n,
+                int16_t *exponent);
+
+/**
+ * @brief  This function computes the power spectrum re^2 + im^2 of a block
+ *         of bins. With the block exponent e of the spectrum, the power is
+ *         power * 2^(2e) in q2.30 units.
+ * @param  spectrum: array of n bins
+ * @param  power: array of n powers
+ * @param  n: number of bins
+ */
+void lw_rfft_power_q15(const complex_q15_t *spectrum, uint32_t *power,
+                       uint32_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_RFFT_H_*/
+
+/*** End of File *************************************************************/
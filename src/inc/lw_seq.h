@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Filename              :   lw_seq.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_seq.h
+ *  @brief This module declares an interface to extract the positive and
+ *         negative sequence components of a three-phase system in
+ *         fixed-point format (decoupled double synchronous reference frame)
+ */
+
+#ifndef LW_SEQ_H_
+#define LW_SEQ_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_seq
+ * \brief           Positive/negative sequence extractor
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief Sequence extractor state type definition
+ */
+typedef struct {
+  int16_t lpf_coef;   /**< decoupling low-pass coefficient in q1.15 format */
+  int32_t pos_q;      /**< filtered positive sequence q, q1.15 in upper 16 bits */
+  int32_t pos_d;      /**< filtered positive sequence d, q1.15 in upper 16 bits */
+  int32_t neg_q;      /**< filtered negative sequence q, q1.15 in upper 16 bits */
+  int32_t neg_d;      /**< filtered negative sequence d, q1.15 in upper 16 bits */
+} seq_t;
+
+/**
+ * @brief Positive and negative sequence components type definition
+ */
+typedef struct {
+  qd_t pos;
+  qd_t neg;
+} seq_out_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a sequence extractor
+ * @param  seq: sequence extractor to initialize
+ * @param  lpf_coef: low-pass coefficient of the decoupling network in q1.15
+ *         format, wf*Ts/(1+wf*Ts) with wf usually set to w/sqrt(2)
+ */
+void lw_seq_init(seq_t *seq, int16_t lpf_coef);
+
+/**
+ * @brief  This function resets the state of a sequence extractor
+ * @param  seq: sequence extractor to reset
+ */
+void lw_seq_reset(seq_t *seq);
+
+/**
+ * @brief  This function runs one step of the sequence extractor. The
+ *         positive sequence is taken on the frame rotating at theta, the
+ *         negative one on the frame rotating at -theta, and each of them is
+ *         decoupled from the 2*theta ripple induced by the other one.
+ * @param  seq: sequence extractor
+ * @param  input: components alpha and beta in alphabeta_t format
+ * @param  theta: angular position of the fundamental in q1.15 format
+ * @retval Positive and negative sequence components in seq_out_t format
+ */
+seq_out_t lw_seq_step(seq_t *seq, alphabeta_t input, int16_t theta);
+
+/**
+ * @brief  This function runs one step of several sequence extractors, one
+ *         for each channel
+ * @param  seq: array of n_channels sequence extractors
+ * @param  input: array of n_channels alpha and beta components
+ * @param  theta: array of n_channels angular positions in q1.15 format
+ * @param  output: array of n_channels positive and negative sequence components
+ * @param  n_channels: number of channels
+ */
+void lw_seq_step_block(seq_t *seq, const alphabeta_t *input, const int16_t *theta,
+                       seq_out_t *output, uint16_t n_channels);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_SEQ_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,129 @@
+/*****************************************************************************
+ * Filename              :   lw_smo.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_smo.h
+ *  @brief This module declares an interface to estimate the back-EMF and
+ *         the rotor angle of a PMSM with a sliding-mode observer in
+ *         fixed-point format
+ */
+
+#ifndef LW_SMO_H_
+#define LW_SMO_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+#include "lw_pll.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_smo
+ * \brief           Sliding-mode back-EMF observer
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Sliding-mode observer type definition. The current model is
+ *                  i[k+1] = f * i[k] + g * (v[k] - z[k])
+ *         with f = 1 - R*Ts/L and g = Ts/L (scaled to the current and
+ *         voltage units), z = k_smo * sat((i_est - i) / band) is the
+ *         switching term and its low-pass filtered value is the back-EMF.
+ */
+typedef struct {
+  int16_t f;            /**< model pole in q1.15 format */
+  int16_t g;            /**< model input gain in q1.15 format */
+  int16_t k_smo;        /**< switching term amplitude, voltage unit */
+  int32_t slope;        /**< k_smo / band in q.15 format */
+  int16_t lpf_coef;     /**< back-EMF low-pass coefficient in q1.15 format */
+  alphabeta_t i_est;    /**< estimated current */
+  int32_t emf_alpha;    /**< filtered back-EMF alpha, upper 16 bits */
+  int32_t emf_beta;     /**< filtered back-EMF beta, upper 16 bits */
+  pll_t pll;            /**< angle tracking loop on the back-EMF */
+  int16_t theta;        /**< estimated rotor angle in q1.15 format */
+} smo_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a sliding-mode observer. The angle
+ *         tracking loop is initialized with lw_pll_init(&smo->pll, ...)
+ *         afterwards.
+ * @param  smo: observer to initialize
+ * @param  f: model pole 1 - R*Ts/L in q1.15 format
+ * @param  g: model input gain Ts/L in q1.15 format
+ * @param  k_smo: switching term amplitude, above the largest back-EMF
+ * @param  band: current error where the switching term saturates (> 0)
+ * @param  lpf_coef: back-EMF low-pass coefficient in q1.15 format
+ */
+void lw_smo_init(smo_t *smo, int16_t f, int16_t g, int16_t k_smo, int16_t band,
+                 int16_t lpf_coef);
+
+/**
+ * @brief  This function runs one step of the observer
+ * @param  smo: observer
+ * @param  current: measured current in alphabeta_t format
+ * @param  voltage: applied voltage in alphabeta_t format
+ * @retval estimated rotor angle in q1.15 format. The back-EMF leads the
+ *         rotor flux by 90 degrees in the direction of rotation; the lag of
+ *         the back-EMF filter is not compensated.
+ */
+int16_t lw_smo_step(smo_t *smo, alphabeta_t current, alphabeta_t voltage);
+
+/**
+ * @brief  This function returns the filtered back-EMF of an observer
+ * @param  smo: observer
+ * @retval back-EMF in alphabeta_t format
+ */
+alphabeta_t lw_smo_get_emf(const smo_t *smo);
+
+/**
+ * @brief  This function runs one step of several observers, one for each
+ *         motor
+ * @param  smo: array of n observers
+ * @param  current: array of n measured currents
+ * @param  voltage: array of n applied voltages
+ * @param  n: number of observers
+ */
+void lw_smo_step_batch(smo_t *smo, const alphabeta_t *current,
+                       const alphabeta_t *voltage, uint16_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_SMO_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,165 @@
+/*****************************************************************************
+ * Filename              :   lw_stream.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_stream.h
+ *  @brief This module declares an interface to run the Clarke and Park
+ *         transformations over sample ring buffers in fixed-point format
+ */
+
+#ifndef LW_STREAM_H_
+#define LW_STREAM_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_stream
+ * \brief           Streaming transformation pipeline
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/* Ring counters are published with release stores and sampled with acquire
+ * loads, so the samples written before a counter update are visible to the
+ * side that reads the new counter, on another core or in an ISR as well.
+ * The side that owns a counter uses these macros to update it too. */
+#if defined(__GNUC__) || defined(__clang__)
+#define LW_RING_LOAD_ACQUIRE(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define LW_RING_STORE_RELEASE(p, v)   __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#elif !defined(__cplusplus) && defined(__STDC_VERSION__) && \
+      (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define LW_RING_LOAD_ACQUIRE(p)       lw_ring_load_acquire(p)
+#define LW_RING_STORE_RELEASE(p, v)   \
+  do { atomic_thread_fence(memory_order_release); *(p) = (v); } while (0)
+#else
+#error "lw_stream: no acquire/release primitives for this compiler"
+#endif
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Ring buffer of a, b samples type definition. The size is mask + 1
+ *         and must be a power of two; head and tail are free running
+ *         counters, so head - tail is the number of stored samples.
+ *
+ *         Threading contract: one producer and one consumer, each of them
+ *         a thread, an ISR or another core. Only the producer writes head
+ *         and only the consumer writes tail. The producer fills buf (and
+ *         theta) first and then publishes head with LW_RING_STORE_RELEASE;
+ *         the consumer reads head with LW_RING_LOAD_ACQUIRE before reading
+ *         the samples and releases them with LW_RING_STORE_RELEASE on tail.
+ */
+typedef struct {
+  ab_t *buf;                /**< sample storage */
+  int16_t *theta;           /**< angle of each sample in q1.15 format, or NULL */
+  uint32_t mask;            /**< size - 1 */
+  volatile uint32_t head;   /**< samples written by the producer */
+  volatile uint32_t tail;   /**< samples read by the pipeline */
+} ab_ring_t;
+
+/**
+ * @brief  Ring buffer of q, d samples type definition, same rules and
+ *         threading contract as ab_ring_t
+ */
+typedef struct {
+  qd_t *buf;                /**< sample storage */
+  uint32_t mask;            /**< size - 1 */
+  volatile uint32_t head;   /**< samples written by the pipeline */
+  volatile uint32_t tail;   /**< samples read by the consumer */
+} qd_ring_t;
+
+/**
+ * @brief  Streaming pipeline type definition
+ */
+typedef struct {
+  int16_t theta;            /**< angle of the next sample when the ring has none */
+  int16_t dtheta;           /**< angle increment per sample in q1.15 format */
+  int16_t lpf_coef;         /**< q, d low-pass coefficient in q1.15, 0 disables it */
+  int32_t q_state;          /**< filtered q, q1.15 in the upper 16 bits */
+  int32_t d_state;          /**< filtered d, q1.15 in the upper 16 bits */
+} stream_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+#if !defined(__GNUC__) && !defined(__clang__)
+/**
+ * @brief  This function reads a ring counter with acquire ordering
+ * @param  p: ring counter
+ * @retval counter value
+ */
+static inline uint32_t lw_ring_load_acquire(volatile uint32_t *p) {
+  uint32_t v = *p;
+  atomic_thread_fence(memory_order_acquire);
+  return (v);
+}
+#endif
+
+/**
+ * @brief  This function initializes a streaming pipeline
+ * @param  stream: pipeline to initialize
+ * @param  theta: angle of the first sample in q1.15 format, used when the
+ *         input ring carries no angles
+ * @param  dtheta: angle increment per sample in q1.15 format
+ * @param  lpf_coef: first order low-pass coefficient applied to q and d in
+ *         q1.15 format, 0 to disable the filter
+ */
+void lw_stream_init(stream_t *stream, int16_t theta, int16_t dtheta,
+                    int16_t lpf_coef);
+
+/**
+ * @brief  This function consumes samples from the input ring, applies the
+ *         Clarke and Park transformations (and the optional low-pass
+ *         filter) in a single pass and writes the result straight into the
+ *         output ring. Wrap-around of both rings is handled by splitting
+ *         the work into contiguous spans. The pipeline is the consumer of
+ *         the input ring and the producer of the output ring.
+ * @param  stream: pipeline
+ * @param  input: ring of a, b samples
+ * @param  output: ring of q, d samples
+ * @param  max_samples: maximum number of samples to process
+ * @retval number of samples processed, limited by the samples available in
+ *         the input ring and by the free space in the output ring
+ */
+uint32_t lw_stream_process(stream_t *stream, ab_ring_t *input,
+                           qd_ring_t *output, uint32_t max_samples);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_STREAM_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * Filename              :   lw_svpwm.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_svpwm.h
+ *  @brief This module declares an interface to compute the space vector
+ *         modulation of a three-phase inverter in fixed-point format
+ */
+
+#ifndef LW_SVPWM_H_
+#define LW_SVPWM_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_svpwm
+ * \brief           Space vector modulation
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Modulation sequence type definition
+ */
+typedef enum {
+  SVPWM_7_SEGMENT = 0,  /**< centered, both zero vectors in every period */
+  SVPWM_5_SEGMENT       /**< one phase clamped to a rail, one zero vector */
+} svpwm_mode_t;
+
+/**
+ * @brief  Space vector modulator type definition
+ */
+typedef struct {
+  uint16_t period;      /**< timer period in counts */
+  int16_t vbus;         /**< DC bus voltage, same unit as the alpha-beta input */
+  int32_t gain;         /**< period / vbus in q.15 format */
+  svpwm_mode_t mode;    /**< modulation sequence */
+} svpwm_t;
+
+/**
+ * @brief  Timer compare values type definition
+ */
+typedef struct {
+  uint16_t cmp_a;       /**< high side on-time of phase a in counts */
+  uint16_t cmp_b;       /**< high side on-time of phase b in counts */
+  uint16_t cmp_c;       /**< high side on-time of phase c in counts */
+  uint8_t sector;       /**< space vector sector, 1 to 6 */
+} svpwm_out_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a space vector modulator. The DC bus
+ *         voltage has to be set with lw_svpwm_set_vbus before running it.
+ * @param  svpwm: modulator to initialize
+ * @param  period: timer period in counts
+ * @param  mode: modulation sequence
+ */
+void lw_svpwm_init(svpwm_t *svpwm, uint16_t period, svpwm_mode_t mode);
+
+/**
+ * @brief  This function updates the DC bus voltage of a modulator. It is
+ *         the only place where a division is performed, so it should be
+ *         called at the bus voltage sampling rate, not at the PWM rate.
+ * @param  svpwm: modulator
+ * @param  vbus: DC bus voltage, same unit as the alpha-beta input
+ */
+void lw_svpwm_set_vbus(svpwm_t *svpwm, int16_t vbus);
+
+/**
+ * @brief  This function computes the timer compare values of the voltage
+ *         vector fed in input. Vectors beyond the linear range are clipped
+ *         on the phase that exceeds the bus.
+ * @param  svpwm: modulator
+ * @param  input: voltage components alpha and beta in alphabeta_t format
+ * @retval Compare values and sector in svpwm_out_t format
+ */
+svpwm_out_t lw_svpwm_run(const svpwm_t *svpwm, alphabeta_t input);
+
+/**
+ * @brief  This function computes the timer compare values of several
+ *         inverters
+ * @param  svpwm: array of n_inverters modulators
+ * @param  input: array of n_inverters voltage vectors
+ * @param  output: array of n_inverters compare values
+ * @param  n_inverters: number of inverters
+ */
+void lw_svpwm_run_batch(const svpwm_t *svpwm, const alphabeta_t *input,
+                        svpwm_out_t *output, uint16_t n_inverters);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_SVPWM_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * Filename              :   lw_thd.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_thd.h
+ *  @brief This module declares an interface to measure the harmonics and
+ *         the total harmonic distortion of q1.15 signals synchronized to
+ *         the fundamental angle
+ */
+
+#ifndef LW_THD_H_
+#define LW_THD_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * \defgroup        lw_thd
+ * \brief           Harmonic distortion analyzer
+ * \{
+ */
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define THD_MAX_ORDERS    16u   /**< largest number of analyzed orders */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Analyzer channel type definition: correlation sums of the window
+ *         in progress and results of the last completed window
+ */
+typedef struct {
+  int64_t acc_q[THD_MAX_ORDERS];      /**< x * cos(k * theta) sums */
+  int64_t acc_d[THD_MAX_ORDERS];      /**< x * sin(k * theta) sums */
+  int16_t amplitude[THD_MAX_ORDERS];  /**< amplitude of every order */
+  int16_t thd;                        /**< THD in q1.15 format, saturated */
+} thd_channel_t;
+
+/**
+ * @brief  Harmonic analyzer type definition. Every sample is projected on
+ *         the harmonic frames of the fundamental angle with
+ *         lw_math_park_multi and the projections are summed over a window
+ *         of whole fundamental periods, delimited by the wraps of the
+ *         angle. The bins follow the fundamental, so a drifting frequency
+ *         does not leak, and only the sums are kept between blocks.
+ */
+typedef struct {
+  const int8_t *orders;   /**< analyzed orders, orders[0] = 1 */
+  thd_channel_t *ch;      /**< channels */
+  uint32_t n_samples;     /**< samples in the window in progress */
+  uint16_t prev_theta;    /**< angle of the previous sample */
+  uint8_t n_orders;       /**< number of orders */
+  uint8_t n_channels;     /**< number of channels */
+  uint8_t n_cycles;       /**< fundamental periods per window */
+  uint8_t cycles;         /**< periods in the window in progress */
+  uint8_t primed;         /**< 1 once prev_theta holds a sample */
+  uint8_t synced;         /**< 1 once the first wrap has been seen */
+} thd_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes an analyzer. The first window starts at
+ *         the first wrap of the fundamental angle.
+ * @param  thd: analyzer to initialize
+ * @param  orders: array of n_orders positive orders, the first one 1
+ * @param  n_orders: number of orders, up to THD_MAX_ORDERS
+ * @param  n_cycles: fundamental periods per window (> 0)
+ * @param  ch: array of n_channels channels, owned by the caller
+ * @param  n_channels: number of channels
+ * @retval 0 on success, EINVAL for invalid orders
+ */
+int lw_thd_init(thd_t *thd, const int8_t *orders, uint8_t n_orders,
+                uint8_t n_cycles, thd_channel_t *ch, uint8_t n_channels);
+
+/**
+ * @brief  This function feeds a block of samples to the analyzer. At the
+ *         end of every window the amplitudes (lw_math_sqrt of the averaged
+ *         projections) and the THD of each channel are updated.
+ * @param  thd: analyzer
+ * @param  input: n samples of every channel, interleaved
+ * @param  theta: n fundamental angles in q1.15 format, e.g. from lw_pll
+ * @param  n: number of samples
+ * @retval number of windows completed in the block
+ */
+uint32_t lw_thd_process(thd_t *thd, const int16_t *input, const int16_t *theta,
+                        uint32_t n);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_THD_H_*/
+
+/*** End of File *************************************************************/
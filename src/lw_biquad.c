@@ -0,0 +1,343 @@
+/******************************************************************************
+ * Filename              :   lw_biquad.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_biquad.c
+ *  @brief This module handles the design and the processing of biquad
+ *         filter cascades on q1.15 and q1.31 data
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include "lw_biquad.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define BIQUAD_PI   3.14159265358979323846
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int64_t lw_biquad_quantize(double value, uint8_t q, int64_t max);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function designs a biquad with the bilinear transform
+ *         (audio EQ cookbook formulas). It is meant to run offline or at
+ *         start-up.
+ * @param  design: coefficients to compute
+ * @param  type: response type
+ * @param  f0: cut-off, center or notch frequency in Hz
+ * @param  fs: sampling frequency in Hz
+ * @param  quality: quality factor (0.7071 for a Butterworth low-pass)
+ * @param  gain_db: peak gain of BIQUAD_PEAK in dB, unused otherwise
+ */
+void lw_biquad_design(biquad_design_t *design, biquad_type_t type, double f0,
+                      double fs, double quality, double gain_db) {
+
+  double w0 = (2.0 * BIQUAD_PI * f0) / fs;
+  double cos_w0 = cos(w0);
+  double alpha = sin(w0) / (2.0 * quality);
+  double amp = pow(10.0, gain_db / 40.0);
+  double b0;
+  double b1;
+  double b2;
+  double a0 = 1.0 + alpha;
+  double a1 = -2.0 * cos_w0;
+  double a2 = 1.0 - alpha;
+
+  switch (type) {
+  case BIQUAD_HIGHPASS:
+    b0 = (1.0 + cos_w0) / 2.0;
+    b1 = -(1.0 + cos_w0);
+    b2 = b0;
+    break;
+  case BIQUAD_BANDPASS:
+    b0 = alpha;
+    b1 = 0.0;
+    b2 = -alpha;
+    break;
+  case BIQUAD_NOTCH:
+    b0 = 1.0;
+    b1 = -2.0 * cos_w0;
+    b2 = 1.0;
+    break;
+  case BIQUAD_PEAK:
+    b0 = 1.0 + (alpha * amp);
+    b1 = -2.0 * cos_w0;
+    b2 = 1.0 - (alpha * amp);
+    a0 = 1.0 + (alpha / amp);
+    a2 = 1.0 - (alpha / amp);
+    break;
+  case BIQUAD_LOWPASS:
+  default:
+    b0 = (1.0 - cos_w0) / 2.0;
+    b1 = 1.0 - cos_w0;
+    b2 = b0;
+    break;
+  }
+
+  design->b0 = b0 / a0;
+  design->b1 = b1 / a0;
+  design->b2 = b2 / a0;
+  design->a1 = a1 / a0;
+  design->a2 = a2 / a0;
+}
+
+/**
+ * @brief  This function quantizes biquad coefficients for q1.15 data
+ * @param  coef: coefficients to compute
+ * @param  design: floating point coefficients
+ * @param  q: fractional bits of the coefficients (BIQUAD_Q15_COEF_Q)
+ */
+void lw_biquad_q15_coef(biquad_q15_coef_t *coef, const biquad_design_t *design,
+                        uint8_t q) {
+  coef->b0 = (int16_t)lw_biquad_quantize(design->b0, q, INT16_MAX);
+  coef->b1 = (int16_t)lw_biquad_quantize(design->b1, q, INT16_MAX);
+  coef->b2 = (int16_t)lw_biquad_quantize(design->b2, q, INT16_MAX);
+  coef->a1 = (int16_t)lw_biquad_quantize(design->a1, q, INT16_MAX);
+  coef->a2 = (int16_t)lw_biquad_quantize(design->a2, q, INT16_MAX);
+}
+
+/**
+ * @brief  This function quantizes biquad coefficients for q1.31 data
+ * @param  coef: coefficients to compute
+ * @param  design: floating point coefficients
+ * @param  q: fractional bits of the coefficients (BIQUAD_Q31_COEF_Q)
+ */
+void lw_biquad_q31_coef(biquad_q31_coef_t *coef, const biquad_design_t *design,
+                        uint8_t q) {
+  coef->b0 = (int32_t)lw_biquad_quantize(design->b0, q, INT32_MAX);
+  coef->b1 = (int32_t)lw_biquad_quantize(design->b1, q, INT32_MAX);
+  coef->b2 = (int32_t)lw_biquad_quantize(design->b2, q, INT32_MAX);
+  coef->a1 = (int32_t)lw_biquad_quantize(design->a1, q, INT32_MAX);
+  coef->a2 = (int32_t)lw_biquad_quantize(design->a2, q, INT32_MAX);
+}
+
+/**
+ * @brief  This function initializes a q1.15 cascade with cleared states
+ * @param  bq: cascade to initialize
+ * @param  coef: array of n_sections coefficient sets, owned by the caller
+ * @param  state: array of BIQUAD_STATE_SIZE states, owned by the caller
+ * @param  n_sections: number of sections
+ * @param  shift: fractional bits of the coefficients
+ * @param  n_channels: number of channels
+ */
+void lw_biquad_q15_init(biquad_q15_t *bq, const biquad_q15_coef_t *coef,
+                        int16_t *state, uint8_t n_sections, uint8_t shift,
+                        uint16_t n_channels) {
+
+  uint32_t i;
+
+  bq->coef = coef;
+  bq->state = state;
+  bq->n_sections = n_sections;
+  bq->shift = shift;
+  bq->n_channels = n_channels;
+
+  for (i = 0u; i < BIQUAD_STATE_SIZE(n_sections, n_channels); i++) {
+    state[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function filters a block of interleaved q1.15 samples. The
+ *         sums run on 64-bit accumulators and are rounded once per section.
+ * @param  bq: cascade
+ * @param  input: n_samples * n_channels input samples
+ * @param  output: n_samples * n_channels output samples, may be input
+ * @param  n_samples: number of samples per channel
+ */
+void lw_biquad_q15_process(biquad_q15_t *bq, const int16_t *input,
+                           int16_t *output, uint32_t n_samples) {
+
+  uint32_t n_ch = bq->n_channels;
+  uint32_t n_sec = bq->n_sections;
+  uint8_t shift = bq->shift;
+  int64_t round = ((int64_t)1 << shift) >> 1;
+  const int16_t *src;
+  int16_t *dst;
+  int16_t *x1;
+  int16_t *x2;
+  int16_t *y1;
+  int16_t *y2;
+  biquad_q15_coef_t c;
+  uint32_t k;
+  uint32_t s;
+  uint32_t ch;
+  int16_t x0;
+  int64_t acc;
+
+  for (k = 0u; k < n_samples; k++) {
+    src = &input[k * n_ch];
+    dst = &output[k * n_ch];
+
+    for (s = 0u; s < n_sec; s++) {
+      c = bq->coef[s];
+      x1 = &bq->state[4u * s * n_ch];
+      x2 = &x1[n_ch];
+      y1 = &x2[n_ch];
+      y2 = &y1[n_ch];
+
+      /* the channels are independent: this loop vectorizes */
+      for (ch = 0u; ch < n_ch; ch++) {
+        x0 = src[ch];
+        acc = ((int64_t)c.b0 * x0) + ((int64_t)c.b1 * x1[ch]) +
+              ((int64_t)c.b2 * x2[ch]) - ((int64_t)c.a1 * y1[ch]) -
+              ((int64_t)c.a2 * y2[ch]);
+        acc = (acc + round) >> shift;
+
+        x2[ch] = x1[ch];
+        x1[ch] = x0;
+        y2[ch] = y1[ch];
+        y1[ch] = (int16_t)LIMIT(acc, -INT16_MAX, INT16_MAX);
+        dst[ch] = y1[ch];
+      }
+
+      /* the next section filters the output of this one */
+      src = dst;
+    }
+
+    if (0u == n_sec) {
+      for (ch = 0u; ch < n_ch; ch++) {
+        dst[ch] = src[ch];
+      }
+    }
+  }
+}
+
+/**
+ * @brief  This function initializes a q1.31 cascade with cleared states
+ * @param  bq: cascade to initialize
+ * @param  coef: array of n_sections coefficient sets, owned by the caller
+ * @param  state: array of BIQUAD_STATE_SIZE states, owned by the caller
+ * @param  n_sections: number of sections
+ * @param  shift: fractional bits of the coefficients
+ * @param  n_channels: number of channels
+ */
+void lw_biquad_q31_init(biquad_q31_t *bq, const biquad_q31_coef_t *coef,
+                        int32_t *state, uint8_t n_sections, uint8_t shift,
+                        uint16_t n_channels) {
+
+  uint32_t i;
+
+  bq->coef = coef;
+  bq->state = state;
+  bq->n_sections = n_sections;
+  bq->shift = shift;
+  bq->n_channels = n_channels;
+
+  for (i = 0u; i < BIQUAD_STATE_SIZE(n_sections, n_channels); i++) {
+    state[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function filters a block of interleaved q1.31 samples. The
+ *         sums run on 64-bit accumulators: with q.29 coefficients the five
+ *         products never overflow while their absolute sum stays below 8.
+ * @param  bq: cascade
+ * @param  input: n_samples * n_channels input samples
+ * @param  output: n_samples * n_channels output samples, may be input
+ * @param  n_samples: number of samples per channel
+ */
+void lw_biquad_q31_process(biquad_q31_t *bq, const int32_t *input,
+                           int32_t *output, uint32_t n_samples) {
+
+  uint32_t n_ch = bq->n_channels;
+  uint32_t n_sec = bq->n_sections;
+  uint8_t shift = bq->shift;
+  int64_t round = ((int64_t)1 << shift) >> 1;
+  const int32_t *src;
+  int32_t *dst;
+  int32_t *x1;
+  int32_t *x2;
+  int32_t *y1;
+  int32_t *y2;
+  biquad_q31_coef_t c;
+  uint32_t k;
+  uint32_t s;
+  uint32_t ch;
+  int32_t x0;
+  int64_t acc;
+
+  for (k = 0u; k < n_samples; k++) {
+    src = &input[k * n_ch];
+    dst = &output[k * n_ch];
+
+    for (s = 0u; s < n_sec; s++) {
+      c = bq->coef[s];
+      x1 = &bq->state[4u * s * n_ch];
+      x2 = &x1[n_ch];
+      y1 = &x2[n_ch];
+      y2 = &y1[n_ch];
+
+      /* the channels are independent: this loop vectorizes */
+      for (ch = 0u; ch < n_ch; ch++) {
+        x0 = src[ch];
+        acc = ((int64_t)c.b0 * x0) + ((int64_t)c.b1 * x1[ch]) +
+              ((int64_t)c.b2 * x2[ch]) - ((int64_t)c.a1 * y1[ch]) -
+              ((int64_t)c.a2 * y2[ch]);
+        acc = (acc + round) >> shift;
+
+        x2[ch] = x1[ch];
+        x1[ch] = x0;
+        y2[ch] = y1[ch];
+        y1[ch] = (int32_t)LIMIT(acc, -(int64_t)INT32_MAX, (int64_t)INT32_MAX);
+        dst[ch] = y1[ch];
+      }
+
+      /* the next section filters the output of this one */
+      src = dst;
+    }
+
+    if (0u == n_sec) {
+      for (ch = 0u; ch < n_ch; ch++) {
+        dst[ch] = src[ch];
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Rounds a coefficient to the nearest value in q format
+ * @param  value: coefficient
+ * @param  q: fractional bits
+ * @param  max: largest representable value
+ * @retval coefficient in q format, saturated to [-max, max]
+ */
+static int64_t lw_biquad_quantize(double value, uint8_t q, int64_t max) {
+
+  double scaled = floor((value * (double)((int64_t)1 << q)) + 0.5);
+
+  return ((int64_t)LIMIT(scaled, -(double)max, (double)max));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Filename              :   lw_dtc.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_dtc.c
+ *  @brief This module handles the dead-time compensation in fixed-point
+ *         format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_dtc.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define SQRT3_2   (int32_t)0x6ED9    /* sqrt(3)/2 in q1.15 format=0.8660254*/
+#define ANGLE_90  (int32_t)16384     /* pi/2 in q1.15 format */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static uint16_t lw_dtc_phase(const dtc_t *dtc, int32_t current, uint16_t cmp);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a dead-time compensator. Around zero
+ *         current the compensation follows sin(pi/2 * i/band), read from
+ *         the trigonometric table, and it is full for |i| >= band.
+ * @param  dtc: compensator to initialize
+ * @param  period: timer period in counts, compensated values are clipped to it
+ * @param  dt_counts: dead time plus switching delays in counts
+ * @param  band: current where the compensation reaches its full value (> 0)
+ */
+void lw_dtc_init(dtc_t *dtc, uint16_t period, int16_t dt_counts, int16_t band) {
+
+  dtc->period = period;
+  dtc->dt_counts = dt_counts;
+
+  if (band > 0) {
+    dtc->band_gain = (int32_t)(((int32_t)1 << 29) / (int32_t)band);
+  }
+  else {
+    /* hard sign */
+    dtc->band_gain = (int32_t)1 << 29;
+  }
+}
+
+/**
+ * @brief  This function compensates the compare values using phase
+ *         currents a and b (c is -a-b)
+ * @param  dtc: compensator
+ * @param  current: phase currents a and b in ab_t format, positive out of the leg
+ * @param  duty: commanded compare values in svpwm_out_t format
+ * @retval compensated compare values in svpwm_out_t format
+ */
+svpwm_out_t lw_dtc_run_ab(const dtc_t *dtc, ab_t current, svpwm_out_t duty) {
+
+  svpwm_out_t output;
+
+  output.sector = duty.sector;
+  output.cmp_a = lw_dtc_phase(dtc, (int32_t)current.a, duty.cmp_a);
+  output.cmp_b = lw_dtc_phase(dtc, (int32_t)current.b, duty.cmp_b);
+  output.cmp_c = lw_dtc_phase(dtc, -(int32_t)current.a - (int32_t)current.b,
+                              duty.cmp_c);
+
+  return (output);
+}
+
+/**
+ * @brief  This function compensates the compare values using the current
+ *         components alpha and beta
+ * @param  dtc: compensator
+ * @param  current: current components alpha and beta in alphabeta_t format
+ * @param  duty: commanded compare values in svpwm_out_t format
+ * @retval compensated compare values in svpwm_out_t format
+ */
+svpwm_out_t lw_dtc_run_alphabeta(const dtc_t *dtc, alphabeta_t current,
+                                 svpwm_out_t duty) {
+
+  svpwm_out_t output;
+  int32_t beta_tmp;
+  int32_t alpha_half;
+
+  /* inverse of lw_math_clarke */
+  beta_tmp = (SQRT3_2 * (int32_t)current.beta) / 32768;
+  alpha_half = (int32_t)current.alpha / 2;
+
+  output.sector = duty.sector;
+  output.cmp_a = lw_dtc_phase(dtc, (int32_t)current.alpha, duty.cmp_a);
+  output.cmp_b = lw_dtc_phase(dtc, -alpha_half - beta_tmp, duty.cmp_b);
+  output.cmp_c = lw_dtc_phase(dtc, -alpha_half + beta_tmp, duty.cmp_c);
+
+  return (output);
+}
+
+/**
+ * @brief  This function compensates the compare values of several
+ *         inverters using phase currents a and b
+ * @param  dtc: array of n_inverters compensators
+ * @param  current: array of n_inverters phase currents
+ * @param  duty: array of n_inverters commanded compare values
+ * @param  output: array of n_inverters compensated compare values
+ * @param  n_inverters: number of inverters
+ */
+void lw_dtc_run_ab_batch(const dtc_t *dtc, const ab_t *current,
+                         const svpwm_out_t *duty, svpwm_out_t *output,
+                         uint16_t n_inverters) {
+
+  uint16_t i;
+
+  for (i = 0u; i < n_inverters; i++) {
+    output[i] = lw_dtc_run_ab(&dtc[i], current[i], duty[i]);
+  }
+}
+
+/**
+ * @brief  This function compensates the compare values of several
+ *         inverters using the current components alpha and beta
+ * @param  dtc: array of n_inverters compensators
+ * @param  current: array of n_inverters current vectors
+ * @param  duty: array of n_inverters commanded compare values
+ * @param  output: array of n_inverters compensated compare values
+ * @param  n_inverters: number of inverters
+ */
+void lw_dtc_run_alphabeta_batch(const dtc_t *dtc, const alphabeta_t *current,
+                                const svpwm_out_t *duty, svpwm_out_t *output,
+                                uint16_t n_inverters) {
+
+  uint16_t i;
+
+  for (i = 0u; i < n_inverters; i++) {
+    output[i] = lw_dtc_run_alphabeta(&dtc[i], current[i], duty[i]);
+  }
+}
+
+/**
+ * @brief  Compensates the compare value of one leg. A positive current
+ *         flows through the low side diode during the dead time, so the
+ *         on-time is extended, and the other way round.
+ * @param  dtc: compensator
+ * @param  current: phase current, positive out of the leg
+ * @param  cmp: commanded compare value
+ * @retval compensated compare value clipped to the period
+ */
+static uint16_t lw_dtc_phase(const dtc_t *dtc, int32_t current, uint16_t cmp) {
+
+  int32_t angle;
+  int32_t sign;
+  int32_t out;
+
+  /* smooth sign: sin of the current scaled so that band maps to pi/2 */
+  angle = (int32_t)(((int64_t)current * dtc->band_gain) / 32768);
+
+  if (angle >= ANGLE_90) {
+    sign = INT16_MAX;
+  }
+  else if (angle <= -ANGLE_90) {
+    sign = -INT16_MAX;
+  }
+  else {
+    sign = (int32_t)lw_math_trig_functions((int16_t)angle).sin;
+  }
+
+  out = (int32_t)cmp + ((sign * (int32_t)dtc->dt_counts) / 32768);
+
+  if (out < 0) {
+    out = 0;
+  }
+  else if (out > (int32_t)dtc->period) {
+    out = (int32_t)dtc->period;
+  }
+  else {
+    /* within the period */
+  }
+
+  return ((uint16_t)out);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
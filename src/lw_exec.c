@@ -0,0 +1,281 @@
+/******************************************************************************
+ * Filename              :   lw_exec.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_exec.c
+ *  @brief This module handles the sharded multi-motor executor
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include <stddef.h>
+#include "lw_exec.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int lw_exec_barrier_init(exec_barrier_t *barrier, uint32_t count);
+static void lw_exec_barrier_destroy(exec_barrier_t *barrier);
+static void lw_exec_barrier_resize(exec_barrier_t *barrier, uint32_t count);
+static void lw_exec_barrier_wait(exec_barrier_t *barrier);
+static void lw_exec_shard(exec_t *exec, uint32_t index);
+static void *lw_exec_worker(void *arg);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes an executor and starts n_threads - 1
+ *         worker threads; the thread calling lw_exec_tick is the last one.
+ *         Motors are split in contiguous shards whose size is a multiple of
+ *         LW_EXEC_SHARD_ALIGN.
+ * @param  exec: executor to initialize
+ * @param  motors: motor states, kept by reference
+ * @param  n_threads: number of threads, 1 to LW_EXEC_MAX_THREADS
+ * @param  stage: user stage between Park and reverse Park, or NULL
+ * @param  stage_arg: argument passed to the user stage
+ * @retval 0 on success, an errno value otherwise
+ */
+int lw_exec_init(exec_t *exec, motor_soa_t *motors, uint32_t n_threads,
+                 exec_stage_t stage, void *stage_arg) {
+
+  int err;
+  uint32_t i;
+  uint32_t shard;
+
+  if ((n_threads == 0u) || (n_threads > LW_EXEC_MAX_THREADS)) {
+    return (EINVAL);
+  }
+
+  exec->motors = motors;
+  exec->stage = stage;
+  exec->stage_arg = stage_arg;
+  exec->n_threads = n_threads;
+  exec->stop = 0u;
+
+  /* ceil(n / threads) rounded up to whole cache lines */
+  shard = (motors->n + n_threads - 1u) / n_threads;
+  shard = (shard + LW_EXEC_SHARD_ALIGN - 1u) & ~(LW_EXEC_SHARD_ALIGN - 1u);
+  exec->shard_size = shard;
+
+  err = lw_exec_barrier_init(&exec->start, n_threads);
+  if (0 != err) {
+    return (err);
+  }
+
+  err = lw_exec_barrier_init(&exec->done, n_threads);
+  if (0 != err) {
+    lw_exec_barrier_destroy(&exec->start);
+    return (err);
+  }
+
+  /* shard 0 belongs to the calling thread */
+  for (i = 1u; i < n_threads; i++) {
+    exec->workers[i].exec = exec;
+    exec->workers[i].index = i;
+    err = pthread_create(&exec->threads[i], NULL, lw_exec_worker, &exec->workers[i]);
+    if (0 != err) {
+      /* release the workers already started */
+      exec->n_threads = i;
+      lw_exec_barrier_resize(&exec->start, i);
+      lw_exec_barrier_resize(&exec->done, i);
+      lw_exec_deinit(exec);
+      return (err);
+    }
+  }
+
+  return (0);
+}
+
+/**
+ * @brief  This function runs one tick on every motor: Clarke and Park of
+ *         the phase currents, the user stage, then reverse Park of the
+ *         voltage commands. It returns when all the shards are done.
+ * @param  exec: executor
+ */
+void lw_exec_tick(exec_t *exec) {
+  lw_exec_barrier_wait(&exec->start);
+  lw_exec_shard(exec, 0u);
+  lw_exec_barrier_wait(&exec->done);
+}
+
+/**
+ * @brief  This function stops the worker threads and releases the executor
+ * @param  exec: executor
+ */
+void lw_exec_deinit(exec_t *exec) {
+
+  uint32_t i;
+
+  exec->stop = 1u;
+  lw_exec_barrier_wait(&exec->start);
+
+  for (i = 1u; i < exec->n_threads; i++) {
+    (void)pthread_join(exec->threads[i], NULL);
+  }
+
+  lw_exec_barrier_destroy(&exec->start);
+  lw_exec_barrier_destroy(&exec->done);
+}
+
+/**
+ * @brief  Initializes a barrier
+ * @param  barrier: barrier to initialize
+ * @param  count: number of threads meeting at the barrier
+ * @retval 0 on success, an errno value otherwise
+ */
+static int lw_exec_barrier_init(exec_barrier_t *barrier, uint32_t count) {
+
+  int err;
+
+  barrier->count = count;
+  barrier->waiting = 0u;
+  barrier->phase = 0u;
+
+  err = pthread_mutex_init(&barrier->mutex, NULL);
+  if (0 == err) {
+    err = pthread_cond_init(&barrier->cond, NULL);
+    if (0 != err) {
+      (void)pthread_mutex_destroy(&barrier->mutex);
+    }
+  }
+
+  return (err);
+}
+
+/**
+ * @brief  Releases a barrier
+ * @param  barrier: barrier to release
+ */
+static void lw_exec_barrier_destroy(exec_barrier_t *barrier) {
+  (void)pthread_cond_destroy(&barrier->cond);
+  (void)pthread_mutex_destroy(&barrier->mutex);
+}
+
+/**
+ * @brief  Changes the number of threads meeting at a barrier. Threads may
+ *         already be waiting on it, so the count is written under the
+ *         barrier mutex; the new count must exceed the waiting threads.
+ * @param  barrier: barrier
+ * @param  count: number of threads meeting at the barrier
+ */
+static void lw_exec_barrier_resize(exec_barrier_t *barrier, uint32_t count) {
+  (void)pthread_mutex_lock(&barrier->mutex);
+  barrier->count = count;
+  (void)pthread_mutex_unlock(&barrier->mutex);
+}
+
+/**
+ * @brief  Waits until all the threads reach the barrier. The phase counter
+ *         makes the barrier reusable straight away.
+ * @param  barrier: barrier
+ */
+static void lw_exec_barrier_wait(exec_barrier_t *barrier) {
+
+  uint32_t phase;
+
+  (void)pthread_mutex_lock(&barrier->mutex);
+
+  phase = barrier->phase;
+  barrier->waiting++;
+
+  if (barrier->waiting == barrier->count) {
+    barrier->waiting = 0u;
+    barrier->phase++;
+    (void)pthread_cond_broadcast(&barrier->cond);
+  }
+  else {
+    while (phase == barrier->phase) {
+      (void)pthread_cond_wait(&barrier->cond, &barrier->mutex);
+    }
+  }
+
+  (void)pthread_mutex_unlock(&barrier->mutex);
+}
+
+/**
+ * @brief  Runs one tick on a shard. Every kernel works element by element,
+ *         so the results do not depend on how the motors are split.
+ * @param  exec: executor
+ * @param  index: shard index
+ */
+static void lw_exec_shard(exec_t *exec, uint32_t index) {
+
+  motor_soa_t *m = exec->motors;
+  uint32_t first = index * exec->shard_size;
+  uint32_t count;
+
+  if (first >= m->n) {
+    return;
+  }
+
+  count = m->n - first;
+  if (count > exec->shard_size) {
+    count = exec->shard_size;
+  }
+
+  /* one trigonometric evaluation per motor serves both Park transforms */
+  lw_motor_soa_update_trig(m, first, count);
+
+  lw_math_clarke_soa(&m->i_a[first], &m->i_b[first], &m->i_alpha[first],
+                     &m->i_beta[first], count);
+  lw_math_park_trig_soa(&m->i_alpha[first], &m->i_beta[first], &m->cos[first],
+                        &m->sin[first], &m->i_q[first], &m->i_d[first], count);
+
+  if (NULL != exec->stage) {
+    exec->stage(m, first, count, exec->stage_arg);
+  }
+
+  lw_math_rev_park_trig_soa(&m->v_q[first], &m->v_d[first], &m->cos[first],
+                            &m->sin[first], &m->v_alpha[first], &m->v_beta[first],
+                            count);
+}
+
+/**
+ * @brief  Worker thread body: one shard per tick until the executor stops
+ * @param  arg: worker context
+ * @retval NULL
+ */
+static void *lw_exec_worker(void *arg) {
+
+  exec_worker_t *worker = (exec_worker_t *)arg;
+  exec_t *exec = worker->exec;
+
+  for (;;) {
+    lw_exec_barrier_wait(&exec->start);
+    if (0u != exec->stop) {
+      break;
+    }
+    lw_exec_shard(exec, worker->index);
+    lw_exec_barrier_wait(&exec->done);
+  }
+
+  return (NULL);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,550 @@
+/******************************************************************************
+ * Filename              :   lw_fft.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_fft.c
+ *  @brief This module handles in-place radix-2 FFTs on q1.15 and q1.31 data
+ *         with block floating point scaling
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include "lw_fft.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define FFT_BLOCK_LOG2    10u             /* 1024 points per cache block */
+#define FFT_MAX_BLOCKS    (1u << (LW_FFT_MAX_LOG2N - FFT_BLOCK_LOG2))
+#define PI_Q29            1686629713      /* pi in q3.29 format */
+#define Q15_LIMIT_1       11585           /* 32767 / (2 * sqrt(2)) */
+#define Q15_LIMIT_2       23170           /* 32767 / sqrt(2) */
+#define Q31_LIMIT_1       759250124       /* 2^31 / (2 * sqrt(2)) */
+#define Q31_LIMIT_2       1518500249      /* 2^31 / sqrt(2) */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define ABS(x) (((x) < 0) ? -(x) : (x))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int32_t lw_fft_q1_sin(uint32_t i);
+static uint32_t lw_fft_bitrev_index(uint32_t i, uint8_t log2n);
+static uint8_t lw_fft_shift_q15(int32_t max);
+static uint8_t lw_fft_shift_q31(int64_t max);
+static int32_t lw_fft_stage_q15(complex_q15_t *x, uint32_t len, uint8_t log2h,
+                                fft_dir_t dir, uint8_t shift);
+static int64_t lw_fft_stage_q31(complex_q31_t *x, uint32_t len, uint8_t log2h,
+                                fft_dir_t dir, uint8_t shift);
+static int16_t lw_fft_stages_q15(complex_q15_t *x, uint32_t len, uint8_t log2h,
+                                 uint8_t n_stages, fft_dir_t dir, int32_t *max);
+static int16_t lw_fft_stages_q31(complex_q31_t *x, uint32_t len, uint8_t log2h,
+                                 uint8_t n_stages, fft_dir_t dir, int64_t *max);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function returns the cosine and the sine of a phase. The
+ *         coarse angle comes from the first quadrant of the sin_cos_table
+ *         through lw_math_trig_functions (1024 steps per turn) and the
+ *         remainder is applied with a second order rotation, so no other
+ *         table is needed. The accuracy is the one of the q1.15 table.
+ * @param  phase: angle as a fraction of a turn, 2^32 = 2*pi
+ * @retval cosine and sine in q1.31 format
+ */
+fft_twiddle_t lw_fft_twiddle(uint32_t phase) {
+
+  fft_twiddle_t tw;
+  uint32_t i = (phase >> 22) & 0xFFu;
+  int64_t sin_b = (int64_t)lw_fft_q1_sin(i) * 65536;
+  int64_t cos_b = (int64_t)lw_fft_q1_sin(256u - i) * 65536;
+  int64_t c;
+  int64_t s;
+  int64_t delta;
+  int64_t half_sq;
+
+  /* quadrant rotation of the first quadrant values */
+  switch (phase >> 30) {
+  case 1u:
+    c = -sin_b;
+    s = cos_b;
+    break;
+  case 2u:
+    c = -cos_b;
+    s = -sin_b;
+    break;
+  case 3u:
+    c = sin_b;
+    s = -cos_b;
+    break;
+  default:
+    c = cos_b;
+    s = sin_b;
+    break;
+  }
+
+  /* remainder below one table step: delta = 2*pi*fine/2^32 in q1.31 format,
+   * cos(delta) = 1 - delta^2/2 and sin(delta) = delta within 2^-31 */
+  delta = ((int64_t)(phase & 0x3FFFFFu) * PI_Q29) >> 29;
+  half_sq = (delta * delta) >> 32;
+
+  tw.cos = (int32_t)(c - ((c * half_sq) >> 31) - ((s * delta) >> 31));
+  tw.sin = (int32_t)(s - ((s * half_sq) >> 31) + ((c * delta) >> 31));
+
+  return (tw);
+}
+
+/**
+ * @brief  This function runs an in-place FFT on q1.15 data. The stages are
+ *         decimation in frequency; when an input could overflow a stage,
+ *         that stage scales its inputs by 2 or 4 and the block exponent
+ *         grows accordingly. Above 1024 points the last stages run block
+ *         by block on 1024 points that stay in cache, and the blocks are
+ *         aligned to a common exponent at the end.
+ * @param  data: array of 2^log2n samples, overwritten with the transform
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ * @param  dir: transform direction
+ * @param  order: output order
+ * @param  exponent: block exponent, the transform is data * 2^exponent
+ * @retval 0 on success, EINVAL for an unsupported size
+ */
+int lw_fft_q15(complex_q15_t *data, uint8_t log2n, fft_dir_t dir,
+               fft_order_t order, int16_t *exponent) {
+
+  uint32_t n;
+  uint32_t i;
+  uint32_t b;
+  uint32_t n_blocks;
+  uint8_t log2b;
+  uint8_t align;
+  int32_t max = 0;
+  int32_t blk_max;
+  int32_t top_max;
+  int16_t exp_top;
+  int16_t exp_max = 0;
+  int16_t blk_exp[FFT_MAX_BLOCKS];
+
+  if ((log2n < 1u) || (log2n > LW_FFT_MAX_LOG2N)) {
+    return (EINVAL);
+  }
+
+  n = (uint32_t)1 << log2n;
+  for (i = 0u; i < n; i++) {
+    max = (ABS((int32_t)data[i].re) > max) ? ABS((int32_t)data[i].re) : max;
+    max = (ABS((int32_t)data[i].im) > max) ? ABS((int32_t)data[i].im) : max;
+  }
+
+  /* first stages over the whole array, then the last FFT_BLOCK_LOG2
+   * stages block by block: DIF sub-transforms are contiguous */
+  log2b = (log2n > FFT_BLOCK_LOG2) ? (uint8_t)FFT_BLOCK_LOG2 : log2n;
+  exp_top = lw_fft_stages_q15(data, n, (uint8_t)(log2n - 1u),
+                              (uint8_t)(log2n - log2b), dir, &max);
+
+  n_blocks = n >> log2b;
+  top_max = max;
+  for (b = 0u; b < n_blocks; b++) {
+    blk_max = top_max;
+    blk_exp[b] = lw_fft_stages_q15(&data[b << log2b], (uint32_t)1 << log2b,
+                                   (uint8_t)(log2b - 1u), log2b, dir, &blk_max);
+    exp_max = (blk_exp[b] > exp_max) ? blk_exp[b] : exp_max;
+  }
+
+  /* common block exponent */
+  for (b = 0u; b < n_blocks; b++) {
+    align = (uint8_t)(exp_max - blk_exp[b]);
+    if (align > 0u) {
+      for (i = b << log2b; i < ((b + 1u) << log2b); i++) {
+        data[i].re = (int16_t)(((int32_t)data[i].re + (((int32_t)1 << align) >> 1)) >> align);
+        data[i].im = (int16_t)(((int32_t)data[i].im + (((int32_t)1 << align) >> 1)) >> align);
+      }
+    }
+  }
+
+  if (FFT_ORDER_NATURAL == order) {
+    lw_fft_bitrev_q15(data, log2n);
+  }
+
+  *exponent = (int16_t)(exp_top + exp_max);
+
+  return (0);
+}
+
+/**
+ * @brief  This function runs an in-place FFT on q1.31 data, as lw_fft_q15
+ * @param  data: array of 2^log2n samples, overwritten with the transform
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ * @param  dir: transform direction
+ * @param  order: output order
+ * @param  exponent: block exponent, the transform is data * 2^exponent
+ * @retval 0 on success, EINVAL for an unsupported size
+ */
+int lw_fft_q31(complex_q31_t *data, uint8_t log2n, fft_dir_t dir,
+               fft_order_t order, int16_t *exponent) {
+
+  uint32_t n;
+  uint32_t i;
+  uint32_t b;
+  uint32_t n_blocks;
+  uint8_t log2b;
+  uint8_t align;
+  int64_t max = 0;
+  int64_t blk_max;
+  int64_t top_max;
+  int16_t exp_top;
+  int16_t exp_max = 0;
+  int16_t blk_exp[FFT_MAX_BLOCKS];
+
+  if ((log2n < 1u) || (log2n > LW_FFT_MAX_LOG2N)) {
+    return (EINVAL);
+  }
+
+  n = (uint32_t)1 << log2n;
+  for (i = 0u; i < n; i++) {
+    max = (ABS((int64_t)data[i].re) > max) ? ABS((int64_t)data[i].re) : max;
+    max = (ABS((int64_t)data[i].im) > max) ? ABS((int64_t)data[i].im) : max;
+  }
+
+  /* first stages over the whole array, then the last FFT_BLOCK_LOG2
+   * stages block by block: DIF sub-transforms are contiguous */
+  log2b = (log2n > FFT_BLOCK_LOG2) ? (uint8_t)FFT_BLOCK_LOG2 : log2n;
+  exp_top = lw_fft_stages_q31(data, n, (uint8_t)(log2n - 1u),
+                              (uint8_t)(log2n - log2b), dir, &max);
+
+  n_blocks = n >> log2b;
+  top_max = max;
+  for (b = 0u; b < n_blocks; b++) {
+    blk_max = top_max;
+    blk_exp[b] = lw_fft_stages_q31(&data[b << log2b], (uint32_t)1 << log2b,
+                                   (uint8_t)(log2b - 1u), log2b, dir, &blk_max);
+    exp_max = (blk_exp[b] > exp_max) ? blk_exp[b] : exp_max;
+  }
+
+  /* common block exponent */
+  for (b = 0u; b < n_blocks; b++) {
+    align = (uint8_t)(exp_max - blk_exp[b]);
+    if (align > 0u) {
+      for (i = b << log2b; i < ((b + 1u) << log2b); i++) {
+        data[i].re = (int32_t)(((int64_t)data[i].re + (((int64_t)1 << align) >> 1)) >> align);
+        data[i].im = (int32_t)(((int64_t)data[i].im + (((int64_t)1 << align) >> 1)) >> align);
+      }
+    }
+  }
+
+  if (FFT_ORDER_NATURAL == order) {
+    lw_fft_bitrev_q31(data, log2n);
+  }
+
+  *exponent = (int16_t)(exp_top + exp_max);
+
+  return (0);
+}
+
+/**
+ * @brief  This function reorders q1.15 data between natural and bit-reversed
+ *         order
+ * @param  data: array of 2^log2n samples
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ */
+void lw_fft_bitrev_q15(complex_q15_t *data, uint8_t log2n) {
+
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t i;
+  uint32_t j;
+  complex_q15_t tmp;
+
+  for (i = 1u; i < (n - 1u); i++) {
+    j = lw_fft_bitrev_index(i, log2n);
+    if (j > i) {
+      tmp = data[i];
+      data[i] = data[j];
+      data[j] = tmp;
+    }
+  }
+}
+
+/**
+ * @brief  This function reorders q1.31 data between natural and bit-reversed
+ *         order
+ * @param  data: array of 2^log2n samples
+ * @param  log2n: base 2 logarithm of the size, 1 to LW_FFT_MAX_LOG2N
+ */
+void lw_fft_bitrev_q31(complex_q31_t *data, uint8_t log2n) {
+
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t i;
+  uint32_t j;
+  complex_q31_t tmp;
+
+  for (i = 1u; i < (n - 1u); i++) {
+    j = lw_fft_bitrev_index(i, log2n);
+    if (j > i) {
+      tmp = data[i];
+      data[i] = data[j];
+      data[j] = tmp;
+    }
+  }
+}
+
+/**
+ * @brief  Runs one radix-2 decimation in frequency stage on q1.15 data
+ * @param  x: samples
+ * @param  len: number of samples, multiple of 2^(log2h + 1)
+ * @param  log2h: base 2 logarithm of the butterfly span
+ * @param  dir: transform direction
+ * @param  shift: input scaling of the stage, 0 to 2 bits
+ * @retval largest absolute component of the outputs
+ */
+static int32_t lw_fft_stage_q15(complex_q15_t *x, uint32_t len, uint8_t log2h,
+                                fft_dir_t dir, uint8_t shift) {
+
+  uint32_t h = (uint32_t)1 << log2h;
+  uint32_t j;
+  uint32_t base;
+  complex_q15_t *p;
+  complex_q15_t *q;
+  fft_twiddle_t tw;
+  int32_t w_re;
+  int32_t w_im;
+  int32_t rnd = (((int32_t)1 << shift) >> 1);
+  int32_t a_re;
+  int32_t a_im;
+  int32_t b_re;
+  int32_t b_im;
+  int32_t d_re;
+  int32_t d_im;
+  int32_t max = 0;
+
+  for (j = 0u; j < h; j++) {
+    /* w = exp(-i*2*pi*j/(2h)), conjugated for the inverse transform */
+    if (0u == j) {
+      w_re = 32768;
+      w_im = 0;
+    }
+    else {
+      tw = lw_fft_twiddle(j << (31u - log2h));
+      w_re = ((int32_t)tw.cos + 32768) >> 16;
+      w_im = ((int32_t)tw.sin + 32768) >> 16;
+      w_im = (FFT_FORWARD == dir) ? -w_im : w_im;
+    }
+
+    for (base = j; base < len; base += 2u * h) {
+      p = &x[base];
+      q = &x[base + h];
+
+      /* the inputs are scaled first: the outputs then always fit */
+      a_re = ((int32_t)p->re + rnd) >> shift;
+      a_im = ((int32_t)p->im + rnd) >> shift;
+      b_re = ((int32_t)q->re + rnd) >> shift;
+      b_im = ((int32_t)q->im + rnd) >> shift;
+      d_re = a_re - b_re;
+      d_im = a_im - b_im;
+
+      p->re = (int16_t)(a_re + b_re);
+      p->im = (int16_t)(a_im + b_im);
+      q->re = (int16_t)(((d_re * w_re) - (d_im * w_im) + 16384) >> 15);
+      q->im = (int16_t)(((d_re * w_im) + (d_im * w_re) + 16384) >> 15);
+
+      max = (ABS((int32_t)p->re) > max) ? ABS((int32_t)p->re) : max;
+      max = (ABS((int32_t)p->im) > max) ? ABS((int32_t)p->im) : max;
+      max = (ABS((int32_t)q->re) > max) ? ABS((int32_t)q->re) : max;
+      max = (ABS((int32_t)q->im) > max) ? ABS((int32_t)q->im) : max;
+    }
+  }
+
+  return (max);
+}
+
+/**
+ * @brief  Runs n_stages stages on q1.15 data from the span 2^log2h down,
+ *         choosing the scaling of each stage from its largest input
+ * @param  x: samples
+ * @param  len: number of samples, multiple of 2^(log2h + 1)
+ * @param  log2h: base 2 logarithm of the first butterfly span
+ * @param  n_stages: number of stages, at most log2h + 1
+ * @param  dir: transform direction
+ * @param  max: largest absolute component of the input, updated
+ * @retval exponent added by the stages
+ */
+static int16_t lw_fft_stages_q15(complex_q15_t *x, uint32_t len, uint8_t log2h,
+                                 uint8_t n_stages, fft_dir_t dir, int32_t *max) {
+
+  uint8_t s;
+  uint8_t shift;
+  int16_t stage_exp = 0;
+
+  for (s = 0u; s < n_stages; s++) {
+    shift = lw_fft_shift_q15(*max);
+    *max = lw_fft_stage_q15(x, len, (uint8_t)(log2h - s), dir, shift);
+    stage_exp = (int16_t)(stage_exp + shift);
+  }
+
+  return (stage_exp);
+}
+
+/**
+ * @brief  Runs one radix-2 decimation in frequency stage on q1.31 data
+ * @param  x: samples
+ * @param  len: number of samples, multiple of 2^(log2h + 1)
+ * @param  log2h: base 2 logarithm of the butterfly span
+ * @param  dir: transform direction
+ * @param  shift: input scaling of the stage, 0 to 2 bits
+ * @retval largest absolute component of the outputs
+ */
+static int64_t lw_fft_stage_q31(complex_q31_t *x, uint32_t len, uint8_t log2h,
+                                fft_dir_t dir, uint8_t shift) {
+
+  uint32_t h = (uint32_t)1 << log2h;
+  uint32_t j;
+  uint32_t base;
+  complex_q31_t *p;
+  complex_q31_t *q;
+  fft_twiddle_t tw;
+  int64_t w_re;
+  int64_t w_im;
+  int64_t rnd = (((int64_t)1 << shift) >> 1);
+  int64_t a_re;
+  int64_t a_im;
+  int64_t b_re;
+  int64_t b_im;
+  int64_t d_re;
+  int64_t d_im;
+  int64_t max = 0;
+
+  for (j = 0u; j < h; j++) {
+    /* w = exp(-i*2*pi*j/(2h)), conjugated for the inverse transform */
+    if (0u == j) {
+      w_re = (int64_t)2147483648;
+      w_im = 0;
+    }
+    else {
+      tw = lw_fft_twiddle(j << (31u - log2h));
+      w_re = tw.cos;
+      w_im = tw.sin;
+      w_im = (FFT_FORWARD == dir) ? -w_im : w_im;
+    }
+
+    for (base = j; base < len; base += 2u * h) {
+      p = &x[base];
+      q = &x[base + h];
+
+      /* the inputs are scaled first: the outputs then always fit */
+      a_re = ((int64_t)p->re + rnd) >> shift;
+      a_im = ((int64_t)p->im + rnd) >> shift;
+      b_re = ((int64_t)q->re + rnd) >> shift;
+      b_im = ((int64_t)q->im + rnd) >> shift;
+      d_re = a_re - b_re;
+      d_im = a_im - b_im;
+
+      p->re = (int32_t)(a_re + b_re);
+      p->im = (int32_t)(a_im + b_im);
+      q->re = (int32_t)(((d_re * w_re) - (d_im * w_im) + (int64_t)1073741824) >> 31);
+      q->im = (int32_t)(((d_re * w_im) + (d_im * w_re) + (int64_t)1073741824) >> 31);
+
+      max = (ABS((int64_t)p->re) > max) ? ABS((int64_t)p->re) : max;
+      max = (ABS((int64_t)p->im) > max) ? ABS((int64_t)p->im) : max;
+      max = (ABS((int64_t)q->re) > max) ? ABS((int64_t)q->re) : max;
+      max = (ABS((int64_t)q->im) > max) ? ABS((int64_t)q->im) : max;
+    }
+  }
+
+  return (max);
+}
+
+/**
+ * @brief  Runs n_stages stages on q1.31 data from the span 2^log2h down,
+ *         choosing the scaling of each stage from its largest input
+ * @param  x: samples
+ * @param  len: number of samples, multiple of 2^(log2h + 1)
+ * @param  log2h: base 2 logarithm of the first butterfly span
+ * @param  n_stages: number of stages, at most log2h + 1
+ * @param  dir: transform direction
+ * @param  max: largest absolute component of the input, updated
+ * @retval exponent added by the stages
+ */
+static int16_t lw_fft_stages_q31(complex_q31_t *x, uint32_t len, uint8_t log2h,
+                                 uint8_t n_stages, fft_dir_t dir, int64_t *max) {
+
+  uint8_t s;
+  uint8_t shift;
+  int16_t stage_exp = 0;
+
+  for (s = 0u; s < n_stages; s++) {
+    shift = lw_fft_shift_q31(*max);
+    *max = lw_fft_stage_q31(x, len, (uint8_t)(log2h - s), dir, shift);
+    stage_exp = (int16_t)(stage_exp + shift);
+  }
+
+  return (stage_exp);
+}
+
+/**
+ * @brief  Returns sin(i*pi/512) for i in [0, 256] from the first quadrant of
+ *         the sin_cos_table, the only reads of the table that are exact
+ * @param  i: table step
+ * @retval sine in q1.15 format
+ */
+static int32_t lw_fft_q1_sin(uint32_t i) {
+  return ((i >= 256u) ? INT16_MAX : lw_math_trig_functions((int16_t)(i << 6)).sin);
+}
+
+/**
+ * @brief  Reverses the log2n low bits of an index
+ * @param  i: index
+ * @param  log2n: number of bits
+ * @retval reversed index
+ */
+static uint32_t lw_fft_bitrev_index(uint32_t i, uint8_t log2n) {
+
+  uint32_t r = i;
+
+  r = ((r >> 1) & 0x5555u) | ((r & 0x5555u) << 1);
+  r = ((r >> 2) & 0x3333u) | ((r & 0x3333u) << 2);
+  r = ((r >> 4) & 0x0F0Fu) | ((r & 0x0F0Fu) << 4);
+  r = ((r >> 8) & 0x00FFu) | ((r & 0x00FFu) << 8);
+
+  return (r >> (16u - log2n));
+}
+
+/**
+ * @brief  Chooses the input scaling of a q1.15 stage: the butterfly output
+ *         grows at most by 2*sqrt(2)
+ * @param  max: largest absolute component of the input
+ * @retval input scaling in bits
+ */
+static uint8_t lw_fft_shift_q15(int32_t max) {
+  return ((max <= Q15_LIMIT_1) ? 0u : ((max <= Q15_LIMIT_2) ? 1u : 2u));
+}
+
+/**
+ * @brief  Chooses the input scaling of a q1.31 stage: the butterfly output
+ *         grows at most by 2*sqrt(2)
+ * @param  max: largest absolute component of the input
+ * @retval input scaling in bits
+ */
+static uint8_t lw_fft_shift_q31(int64_t max) {
+  return ((max <= Q31_LIMIT_1) ? 0u : ((max <= Q31_LIMIT_2) ? 1u : 2u));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,183 @@
+/******************************************************************************
+ * Filename              :   lw_fir.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_fir.c
+ *  @brief This module handles FIR filters on q1.15 data
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_fir.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void lw_fir_push(fir_t *fir, int16_t input);
+static int16_t lw_fir_dot(const fir_t *fir);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a filter with a cleared delay line
+ * @param  fir: filter to initialize
+ * @param  coef: array of n_taps coefficients in q1.15 format, owned by the
+ *         caller
+ * @param  delay: array of FIR_DELAY_SIZE samples, owned by the caller
+ * @param  n_taps: number of taps (> 0)
+ * @param  decim: decimation factor of lw_fir_decimate (> 0)
+ */
+void lw_fir_init(fir_t *fir, const int16_t *coef, int16_t *delay,
+                 uint16_t n_taps, uint16_t decim) {
+
+  fir->coef = coef;
+  fir->delay = delay;
+  fir->n_taps = n_taps;
+  fir->decim = (decim > 0u) ? decim : 1u;
+
+  lw_fir_reset(fir);
+}
+
+/**
+ * @brief  This function clears the delay line of a filter
+ * @param  fir: filter
+ */
+void lw_fir_reset(fir_t *fir) {
+
+  uint32_t i;
+
+  for (i = 0u; i < FIR_DELAY_SIZE(fir->n_taps); i++) {
+    fir->delay[i] = 0;
+  }
+
+  fir->pos = 0u;
+  fir->phase = 0u;
+}
+
+/**
+ * @brief  This function filters one sample
+ * @param  fir: filter
+ * @param  input: input sample
+ * @retval output sample, rounded and saturated to [-32767, 32767]
+ */
+int16_t lw_fir_step(fir_t *fir, int16_t input) {
+
+  lw_fir_push(fir, input);
+
+  return (lw_fir_dot(fir));
+}
+
+/**
+ * @brief  This function filters a block of samples
+ * @param  fir: filter
+ * @param  input: array of n input samples
+ * @param  output: array of n output samples, may be input
+ * @param  n: number of samples
+ */
+void lw_fir_process(fir_t *fir, const int16_t *input, int16_t *output,
+                    uint32_t n) {
+
+  uint32_t k;
+
+  for (k = 0u; k < n; k++) {
+    lw_fir_push(fir, input[k]);
+    output[k] = lw_fir_dot(fir);
+  }
+}
+
+/**
+ * @brief  This function filters and decimates a block of samples. Every
+ *         input enters the delay line but the dot product only runs for one
+ *         input out of decim, so the cost per input is n_taps / decim
+ *         multiply-accumulates as with a polyphase structure. The phase is
+ *         kept across blocks of any length.
+ * @param  fir: filter
+ * @param  input: array of n input samples
+ * @param  output: array of at least n / decim + 1 output samples
+ * @param  n: number of input samples
+ * @retval number of output samples written
+ */
+uint32_t lw_fir_decimate(fir_t *fir, const int16_t *input, int16_t *output,
+                         uint32_t n) {
+
+  uint32_t k;
+  uint32_t n_out = 0u;
+
+  for (k = 0u; k < n; k++) {
+    lw_fir_push(fir, input[k]);
+
+    fir->phase++;
+    if (fir->phase >= fir->decim) {
+      fir->phase = 0u;
+      output[n_out] = lw_fir_dot(fir);
+      n_out++;
+    }
+  }
+
+  return (n_out);
+}
+
+/**
+ * @brief  Writes a sample in both halves of the delay line
+ * @param  fir: filter
+ * @param  input: input sample
+ */
+static void lw_fir_push(fir_t *fir, int16_t input) {
+
+  fir->pos = (0u == fir->pos) ? (uint16_t)(fir->n_taps - 1u) : (uint16_t)(fir->pos - 1u);
+  fir->delay[fir->pos] = input;
+  fir->delay[fir->pos + fir->n_taps] = input;
+}
+
+/**
+ * @brief  Computes the output from the newest n_taps samples. The 16 x 16
+ *         products are summed in an int64, so no coefficient set overflows;
+ *         the loop is a contiguous dot product and vectorizes.
+ * @param  fir: filter
+ * @retval output sample, rounded and saturated to [-32767, 32767]
+ */
+static int16_t lw_fir_dot(const fir_t *fir) {
+
+  const int16_t *coef = fir->coef;
+  const int16_t *x = &fir->delay[fir->pos];
+  uint32_t n_taps = fir->n_taps;
+  uint32_t i;
+  int64_t acc = 0;
+
+  for (i = 0u; i < n_taps; i++) {
+    acc += (int32_t)coef[i] * (int32_t)x[i];
+  }
+
+  acc = (acc + 16384) >> 15;
+
+  return ((int16_t)LIMIT(acc, -INT16_MAX, INT16_MAX));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
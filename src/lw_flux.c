@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Filename              :   lw_flux.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_flux.c
+ *  @brief This module handles the voltage-model flux observer in
+ *         fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_flux.h"
+#include "lw_lpf.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define PSI_MAX   ((int64_t)INT16_MAX * 65536)
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int16_t lw_flux_axis(flux_t *flux, int16_t i, int16_t v, int32_t *dc,
+                            int64_t *psi);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a flux observer
+ * @param  flux: observer to initialize
+ * @param  r: stator resistance in q.r_shift format
+ * @param  r_shift: fractional bits of r
+ * @param  l: stator inductance in q.l_shift format, 0 for the stator flux
+ * @param  l_shift: fractional bits of l
+ * @param  gain: integrator gain in q1.15 format
+ * @param  leak: integrator pole in q1.15 format
+ * @param  hp_coef: back-EMF high-pass coefficient in q1.15 format
+ */
+void lw_flux_init(flux_t *flux, int16_t r, uint8_t r_shift, int16_t l,
+                  uint8_t l_shift, int16_t gain, int16_t leak, int16_t hp_coef) {
+
+  flux->r = r;
+  flux->r_shift = r_shift;
+  flux->l = l;
+  flux->l_shift = l_shift;
+  flux->gain = gain;
+  flux->leak = leak;
+  flux->hp_coef = hp_coef;
+
+  lw_flux_reset(flux);
+}
+
+/**
+ * @brief  This function clears the state of a flux observer
+ * @param  flux: observer
+ */
+void lw_flux_reset(flux_t *flux) {
+
+  flux->dc_alpha = 0;
+  flux->dc_beta = 0;
+  flux->psi_alpha = 0;
+  flux->psi_beta = 0;
+}
+
+/**
+ * @brief  This function runs one step of the observer
+ * @param  flux: observer
+ * @param  current: measured current in alphabeta_t format
+ * @param  voltage: applied voltage in alphabeta_t format
+ * @retval flux linkage, magnitude from lw_math_sqrt and angle from
+ *         lw_math_atan2 in the convention of lw_math_park
+ */
+flux_out_t lw_flux_step(flux_t *flux, alphabeta_t current, alphabeta_t voltage) {
+
+  flux_out_t out;
+
+  out.flux.alpha = lw_flux_axis(flux, current.alpha, voltage.alpha,
+                                &flux->dc_alpha, &flux->psi_alpha);
+  out.flux.beta = lw_flux_axis(flux, current.beta, voltage.beta,
+                               &flux->dc_beta, &flux->psi_beta);
+
+  /* both components are within +-32767: the sum of squares fits an int32,
+   * its root reaches 46340 and saturates */
+  out.magnitude = (int16_t)LIMIT(lw_math_sqrt(((int32_t)out.flux.alpha * out.flux.alpha) +
+                                              ((int32_t)out.flux.beta * out.flux.beta)),
+                                 0, INT16_MAX);
+
+  /* the vector at angle theta is (cos(theta), -sin(theta)) */
+  out.angle = lw_math_atan2((int16_t)-out.flux.beta, out.flux.alpha);
+
+  return (out);
+}
+
+/**
+ * @brief  This function runs the observer on a block of samples
+ * @param  flux: observer
+ * @param  current: array of n measured currents
+ * @param  voltage: array of n applied voltages
+ * @param  out: array of n outputs
+ * @param  n: number of samples
+ */
+void lw_flux_process(flux_t *flux, const alphabeta_t *current,
+                     const alphabeta_t *voltage, flux_out_t *out, uint32_t n) {
+
+  uint32_t k;
+
+  for (k = 0u; k < n; k++) {
+    out[k] = lw_flux_step(flux, current[k], voltage[k]);
+  }
+}
+
+/**
+ * @brief  Runs the observer on one axis
+ * @param  flux: observer
+ * @param  i: measured current of the axis
+ * @param  v: applied voltage of the axis
+ * @param  dc: back-EMF offset of the axis, upper 16 bits, updated
+ * @param  psi: stator flux of the axis, q1.15 << 16, updated
+ * @retval flux linkage of the axis
+ */
+static int16_t lw_flux_axis(flux_t *flux, int16_t i, int16_t v, int32_t *dc,
+                            int64_t *psi) {
+
+  int32_t emf;
+  int32_t emf_hp;
+  int32_t out;
+
+  emf = (int32_t)v - (((int32_t)flux->r * (int32_t)i) >> flux->r_shift);
+  emf = LIMIT(emf, -INT16_MAX, INT16_MAX);
+
+  /* drift compensation: remove the slow offset of the back-EMF */
+  emf_hp = emf - lw_lpf_step(dc, (int16_t)emf, flux->hp_coef);
+
+  /* leaky integrator, the product gain * emf_hp is q.30, psi is q.31 */
+  *psi = ((*psi * flux->leak) >> 15) + (((int64_t)flux->gain * emf_hp) * 2);
+  *psi = LIMIT(*psi, -PSI_MAX, PSI_MAX);
+
+  out = (int32_t)(*psi >> 16);
+  if (0 != flux->l) {
+    out -= ((int32_t)flux->l * (int32_t)i) >> flux->l_shift;
+  }
+
+  return ((int16_t)LIMIT(out, -INT16_MAX, INT16_MAX));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
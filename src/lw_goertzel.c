@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Filename              :   lw_goertzel.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_goertzel.c
+ *  @brief This module handles Goertzel DFT bins on q1.15 data
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_goertzel.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define ANGLE_45   8192       /* pi/4 in q1.15 format */
+#define ANGLE_90   16384      /* pi/2 in q1.15 format */
+#define ANGLE_180  32768      /* pi in q1.15 format */
+#define ANGLE_STEP 64         /* angle of one table step */
+#define ONE_Q30    ((int64_t)1 << 30)
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int32_t lw_goertzel_sin_q16(int32_t angle);
+static int64_t lw_goertzel_mul(int32_t coef, int64_t state, uint8_t q);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a bank of bins, all at zero frequency
+ *         and with a cleared window
+ * @param  g: bank of bins
+ * @param  cos: array of n_bins values, owned by the caller
+ * @param  sin: array of n_bins values, owned by the caller
+ * @param  s1: array of n_bins states, owned by the caller
+ * @param  s2: array of n_bins states, owned by the caller
+ * @param  n_bins: number of bins
+ */
+void lw_goertzel_init(goertzel_t *g, int32_t *cos, int32_t *sin, int64_t *s1,
+                      int64_t *s2, uint32_t n_bins) {
+
+  uint32_t i;
+
+  g->cos = cos;
+  g->sin = sin;
+  g->s1 = s1;
+  g->s2 = s2;
+  g->n_bins = n_bins;
+
+  for (i = 0u; i < n_bins; i++) {
+    lw_goertzel_set_bin(g, i, 0);
+  }
+
+  lw_goertzel_reset(g);
+}
+
+/**
+ * @brief  This function sets the frequency of one bin
+ * @param  g: bank of bins
+ * @param  bin: bin index
+ * @param  angle: angle per sample in q1.15 format, 65536 * f / fs, rounded
+ *         to the nearest table step (a multiple of 64, fs / 1024)
+ */
+void lw_goertzel_set_bin(goertzel_t *g, uint32_t bin, int16_t angle) {
+
+  /* w is rounded to a table step and folded to v = min(w, pi - w). Below
+   * pi/4 the half angle identities
+   *   cos(v) = 1 - 2*sin^2(v/2),  sin(v) = 2*sin(v/2)*cos(v/2)
+   * scale the q1.15 rounding of the table by sin(v/2); above, the direct
+   * reads cos(v) = sin(pi/2 - v) and sin(v) are already as good. Either
+   * way the bin is tuned within about 2^-15 rad per sample. */
+  int32_t w = (angle < 0) ? -(int32_t)angle : (int32_t)angle;
+  int32_t v;
+  int64_t sin_half;
+  int64_t cos_half;
+  int32_t cos_w;
+  int32_t sin_w;
+
+  w = (w + (ANGLE_STEP / 2)) & ~(ANGLE_STEP - 1);
+  v = (w <= ANGLE_90) ? w : (ANGLE_180 - w);
+
+  if (v <= ANGLE_45) {
+    /* sin(v/2) and cos(v/2) in q1.16 format */
+    sin_half = lw_goertzel_sin_q16(v / 2);
+    cos_half = lw_goertzel_sin_q16(ANGLE_90 - (v / 2));
+    cos_w = (int32_t)(ONE_Q30 - ((sin_half * sin_half) >> 1));
+    sin_w = (int32_t)((sin_half * cos_half) >> 1);
+  }
+  else {
+    cos_w = lw_goertzel_sin_q16(ANGLE_90 - v) * 16384;
+    sin_w = lw_goertzel_sin_q16(v) * 16384;
+  }
+
+  g->cos[bin] = (w <= ANGLE_90) ? cos_w : -cos_w;
+  g->sin[bin] = (angle < 0) ? -sin_w : sin_w;
+}
+
+/**
+ * @brief  This function clears the window of every bin
+ * @param  g: bank of bins
+ */
+void lw_goertzel_reset(goertzel_t *g) {
+
+  uint32_t i;
+
+  for (i = 0u; i < g->n_bins; i++) {
+    g->s1[i] = 0;
+    g->s2[i] = 0;
+  }
+
+  g->count = 0u;
+}
+
+/**
+ * @brief  This function feeds a block of samples to every bin. The bins
+ *         are independent, so the inner loop runs across them. The states
+ *         grow as N * A / (2 * sin(w)), and as N^2 * A / 2 at zero
+ *         frequency, so they are int64 and the window is capped at
+ *         GOERTZEL_MAX_WINDOW samples: later ones are ignored until the
+ *         next reset.
+ * @param  g: bank of bins
+ * @param  input: array of n samples
+ * @param  n: number of samples
+ */
+void lw_goertzel_process(goertzel_t *g, const int16_t *input, uint32_t n) {
+
+  const int32_t *cos = g->cos;
+  int64_t *s1 = g->s1;
+  int64_t *s2 = g->s2;
+  uint32_t n_bins = g->n_bins;
+  uint32_t k;
+  uint32_t i;
+  int64_t x;
+  int64_t s0;
+
+  n = (n < (GOERTZEL_MAX_WINDOW - g->count)) ? n : (GOERTZEL_MAX_WINDOW - g->count);
+
+  for (k = 0u; k < n; k++) {
+    x = input[k];
+
+    for (i = 0u; i < n_bins; i++) {
+      /* 2 * cos in q2.30 format is cos in q3.29 format */
+      s0 = x + lw_goertzel_mul(cos[i], s1[i], 29u) - s2[i];
+      s2[i] = s1[i];
+      s1[i] = s0;
+    }
+  }
+
+  g->count += n;
+}
+
+/**
+ * @brief  This function returns the DFT of one bin over the samples fed
+ *         since the last reset, scaled so that a sinusoid of amplitude A at
+ *         the bin frequency returns A. The magnitude goes through
+ *         lw_math_sqrt.
+ * @param  g: bank of bins
+ * @param  bin: bin index
+ * @retval bin output
+ */
+goertzel_out_t lw_goertzel_get(const goertzel_t *g, uint32_t bin) {
+
+  goertzel_out_t out;
+  int64_t half_n = (g->count > 1u) ? ((int64_t)g->count / 2) : 1;
+  int64_t re;
+  int64_t im;
+
+  /* y = s[k-1] - exp(-jw) * s[k-2] */
+  re = g->s1[bin] - lw_goertzel_mul(g->cos[bin], g->s2[bin], 30u);
+  im = lw_goertzel_mul(g->sin[bin], g->s2[bin], 30u);
+
+  /* amplitude = 2 * |y| / N */
+  re = re / half_n;
+  im = im / half_n;
+  out.re = (int16_t)LIMIT(re, -INT16_MAX, INT16_MAX);
+  out.im = (int16_t)LIMIT(im, -INT16_MAX, INT16_MAX);
+
+  /* both components are within +-32767: the sum of squares fits an int32 */
+  out.amplitude = (int16_t)LIMIT(lw_math_sqrt(((int32_t)out.re * out.re) +
+                                              ((int32_t)out.im * out.im)),
+                                 0, INT16_MAX);
+
+  return (out);
+}
+
+/**
+ * @brief  Reads sin(angle) in q1.16 format for an angle in [0, pi/2] that is
+ *         a multiple of half a table step, from direct first quadrant reads
+ *         (the mirrored reads are one step off). Between two steps the sum
+ *         of the neighbours is used, within sin * 5e-6 of the exact value.
+ * @param  angle: angle in q1.15 format
+ * @retval sine in q1.16 format
+ */
+static int32_t lw_goertzel_sin_q16(int32_t angle) {
+
+  int32_t lo = angle & ~(ANGLE_STEP - 1);
+  int32_t hi = (lo == angle) ? lo : (lo + ANGLE_STEP);
+
+  return ((int32_t)lw_math_trig_functions((int16_t)lo).sin +
+          (int32_t)lw_math_trig_functions((int16_t)hi).sin);
+}
+
+/**
+ * @brief  Multiplies a state by a coefficient, (coef * state) >> q, with the
+ *         state split in its upper and lower q bits so that neither product
+ *         overflows an int64. The result is the floor of the exact product.
+ * @param  coef: coefficient
+ * @param  state: state
+ * @param  q: fractional bits of the coefficient
+ * @retval product
+ */
+static int64_t lw_goertzel_mul(int32_t coef, int64_t state, uint8_t q) {
+
+  int64_t hi = state >> q;
+  int64_t lo = state & (((int64_t)1 << q) - 1);
+
+  return ((coef * hi) + ((coef * lo) >> q));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
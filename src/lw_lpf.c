@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Filename              :   lw_lpf.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_lpf.c
+ *  @brief This module handles banks of first-order low-pass filters in
+ *         fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include <stddef.h>
+#include "lw_lpf.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define LPF_PI    3.14159265358979323846
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function computes the coefficient of a one-pole low-pass
+ *         filter, 1 - exp(-2*pi*fc/fs). It is meant to run offline or at
+ *         start-up.
+ * @param  fc: cut-off frequency in Hz
+ * @param  fs: sampling frequency in Hz
+ * @retval coefficient in q1.15 format
+ */
+int16_t lw_lpf_coef(double fc, double fs) {
+
+  double coef = 1.0 - exp((-2.0 * LPF_PI * fc) / fs);
+
+  return ((int16_t)LIMIT(FLT2FIX(coef, 15), 0, INT16_MAX));
+}
+
+/**
+ * @brief  This function initializes a bank of filters with cleared outputs
+ * @param  bank: bank of filters
+ * @param  coef: array of n coefficients in q1.15 format, owned by the caller
+ * @param  state: array of n states, owned by the caller
+ * @param  n: number of channels
+ */
+void lw_lpf_bank_init(lpf_bank_t *bank, int16_t *coef, int32_t *state,
+                      uint32_t n) {
+
+  bank->coef = coef;
+  bank->state = state;
+  bank->n = n;
+
+  lw_lpf_bank_reset(bank, NULL);
+}
+
+/**
+ * @brief  This function sets the output of every channel of a bank
+ * @param  bank: bank of filters
+ * @param  value: array of n initial outputs, NULL to clear them
+ */
+void lw_lpf_bank_reset(lpf_bank_t *bank, const int16_t *value) {
+
+  uint32_t i;
+
+  for (i = 0u; i < bank->n; i++) {
+    bank->state[i] = (NULL != value) ? ((int32_t)value[i] * 65536) : 0;
+  }
+}
+
+/**
+ * @brief  This function runs one step of every filter of a bank. The loop
+ *         has no data dependent branches, so it vectorizes across the
+ *         channels.
+ * @param  bank: bank of filters
+ * @param  input: array of n inputs
+ * @param  output: array of n outputs
+ */
+void lw_lpf_bank_step(lpf_bank_t *bank, const int16_t *input, int16_t *output) {
+
+  const int16_t *coef = bank->coef;
+  int32_t *state = bank->state;
+  uint32_t n = bank->n;
+  uint32_t i;
+  int32_t hi;
+  int32_t lo;
+  int32_t upd_hi;
+  int32_t upd_lo;
+
+  for (i = 0u; i < n; i++) {
+    /* FMUL((x << 16) - state, coef, 15) needs 33 x 16 bits: the state is
+     * split in its integer and fractional halves so that both products fit
+     * an int32 and the loop vectorizes. The sum wraps modulo 2^32 but the
+     * updated state, a convex combination of state and input, does not. */
+    hi = state[i] >> 16;
+    lo = state[i] & 0xFFFF;
+    upd_hi = ((int32_t)input[i] - hi) * (int32_t)coef[i];
+    upd_lo = -(lo * (int32_t)coef[i]) >> 15;
+    state[i] = (int32_t)((uint32_t)state[i] + ((uint32_t)upd_hi << 1) + (uint32_t)upd_lo);
+    output[i] = (int16_t)(state[i] >> 16);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
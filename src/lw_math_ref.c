@@ -0,0 +1,814 @@
+/******************************************************************************
+ * Filename              :   lw_math_ref.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_ref.c
+ *  @brief This module handles the double precision reference models and the
+ *         differential checker of the lw_math functions
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include "lw_math_ref.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define REF_PI          3.14159265358979323846
+#define REF_SQRT3       1.73205080756887729353
+#define REF_FULL_SCALE  32768.0
+#define REF_SAT         32767.0
+
+#define DEFAULT_SEED    0x2545F491u
+#define SOA_BLOCK       256u
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Running sums of the error statistics
+ */
+typedef struct {
+  double sum;
+  double sum_abs;
+  double sum_sq;
+} ref_acc_t;
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static double lw_math_ref_sat(double value);
+static uint32_t lw_math_ref_rand(uint32_t *state);
+static double lw_math_ref_wrap(double angle_err);
+static void lw_math_ref_begin(ref_stats_t *stats, ref_acc_t *acc);
+static void lw_math_ref_add(ref_stats_t *stats, ref_acc_t *acc, double err,
+                            int32_t in0, int32_t in1, int32_t in2);
+static void lw_math_ref_end(ref_stats_t *stats, const ref_acc_t *acc);
+static void lw_math_ref_park_one(park_fn_t fn, ref_stats_t *stats, ref_acc_t *acc,
+                                 int16_t x, int16_t y, int16_t theta);
+static void lw_math_ref_rev_park_one(rev_park_fn_t fn, ref_stats_t *stats,
+                                     ref_acc_t *acc, int16_t x, int16_t y,
+                                     int16_t theta);
+static void lw_math_ref_sample(uint32_t i, uint32_t *state, int16_t *x,
+                               int16_t *y, int16_t *theta);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/* component values used to build the edge cases */
+static const int16_t edge_values[] = {
+  (int16_t)-32768, (int16_t)-32767, (int16_t)-16384, (int16_t)-1, 0, 1,
+  16384, 32767
+};
+
+/* angles on and around the quadrant and table boundaries */
+static const int16_t edge_angles[] = {
+  (int16_t)-32768, (int16_t)-32767, (int16_t)-16385, (int16_t)-16384,
+  (int16_t)-16383, (int16_t)-65, (int16_t)-64, (int16_t)-1, 0, 1, 63, 64,
+  16383, 16384, 16385, 32767
+};
+
+/* harmonic orders of the multi-frame Park check, int8_t extremes included */
+static const int8_t multi_orders[] = {
+  1, -1, 2, -2, 5, -5, 7, 11, 13, 127, -128
+};
+
+#define N_EDGE_VALUES (sizeof(edge_values) / sizeof(edge_values[0]))
+#define N_EDGE_ANGLES (sizeof(edge_angles) / sizeof(edge_angles[0]))
+#define N_EDGE_CASES  (N_EDGE_VALUES * N_EDGE_VALUES * N_EDGE_ANGLES)
+#define N_ORDERS      (sizeof(multi_orders) / sizeof(multi_orders[0]))
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  Reference of lw_math_trig_functions: 32768*cos, 32768*sin of
+ *         angle*pi/32768, limited to 32767
+ * @param  angle: angle in q1.15 format
+ * @retval Cos(angle) and Sin(angle) in trig_components_ref_t format
+ */
+trig_components_ref_t lw_math_ref_trig_functions(int16_t angle) {
+
+  trig_components_ref_t output;
+  double rad = ((double)angle * REF_PI) / REF_FULL_SCALE;
+
+  output.cos = lw_math_ref_sat(cos(rad) * REF_FULL_SCALE);
+  output.sin = lw_math_ref_sat(sin(rad) * REF_FULL_SCALE);
+
+  return (output);
+}
+
+/**
+ * @brief  Reference of lw_math_sqrt
+ * @param  input: int32_t number
+ * @retval Square root of input (0 if input < 0)
+ */
+double lw_math_ref_sqrt(int32_t input) {
+  return (input > 0) ? sqrt((double)input) : 0.0;
+}
+
+/**
+ * @brief  Reference of lw_math_atan2: 32768*atan2(y, x)/pi
+ * @param  y: ordinate
+ * @param  x: abscissa
+ * @retval angle in q1.15 scale (0 for the null vector)
+ */
+double lw_math_ref_atan2(int16_t y, int16_t x) {
+  return ((0 == x) && (0 == y)) ? 0.0 :
+         (atan2((double)y, (double)x) * REF_FULL_SCALE) / REF_PI;
+}
+
+/**
+ * @brief  Reference of lw_math_clarke, saturated to [-32767, 32767]
+ * @param  input: component a and b in ab_t format
+ * @retval Components alpha and beta in alphabeta_ref_t format
+ */
+alphabeta_ref_t lw_math_ref_clarke(ab_t input) {
+
+  alphabeta_ref_t output;
+
+  output.alpha = (double)input.a;
+  output.beta = lw_math_ref_sat(-((2.0 * (double)input.b) + (double)input.a) / REF_SQRT3);
+
+  return (output);
+}
+
+/**
+ * @brief  Reference of lw_math_park, saturated to [-32767, 32767]
+ * @param  input: components values alpha and beta in alphabeta_t format
+ * @param  theta: rotating frame angular position in q1.15 format
+ * @retval Components q and d in qd_ref_t format
+ */
+qd_ref_t lw_math_ref_park(alphabeta_t input, int16_t theta) {
+
+  qd_ref_t output;
+  double rad = ((double)theta * REF_PI) / REF_FULL_SCALE;
+
+  output.q = lw_math_ref_sat(((double)input.alpha * cos(rad)) -
+                             ((double)input.beta * sin(rad)));
+  output.d = lw_math_ref_sat(((double)input.alpha * sin(rad)) +
+                             ((double)input.beta * cos(rad)));
+
+  return (output);
+}
+
+/**
+ * @brief  Reference of lw_math_rev_park, saturated to [-32767, 32767]
+ * @param  input: input component q and d in qd_t format
+ * @param  theta: angular position in q1.15 format
+ * @retval output component alpha and beta in alphabeta_ref_t format
+ */
+alphabeta_ref_t lw_math_ref_rev_park(qd_t input, int16_t theta) {
+
+  alphabeta_ref_t output;
+  double rad = ((double)theta * REF_PI) / REF_FULL_SCALE;
+
+  output.alpha = lw_math_ref_sat(((double)input.q * cos(rad)) +
+                                 ((double)input.d * sin(rad)));
+  output.beta = lw_math_ref_sat(-((double)input.q * sin(rad)) +
+                                ((double)input.d * cos(rad)));
+
+  return (output);
+}
+
+/**
+ * @brief  This function checks a trigonometric implementation on every
+ *         one of the 65536 angles
+ * @param  fn: implementation under test
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_trig(trig_fn_t fn, ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  trig_components_t out;
+  trig_components_ref_t ref;
+  int32_t angle;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (angle = -32768; angle <= 32767; angle++) {
+    out = fn((int16_t)angle);
+    ref = lw_math_ref_trig_functions((int16_t)angle);
+    lw_math_ref_add(stats, &acc, (double)out.cos - ref.cos, angle, 0, 0);
+    lw_math_ref_add(stats, &acc, (double)out.sin - ref.sin, angle, 0, 0);
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a square root implementation on the edge
+ *         cases (zero, negatives, perfect squares and their neighbours,
+ *         INT32_MAX) and on n_random random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_sqrt(sqrt_fn_t fn, uint32_t n_random, uint32_t seed,
+                            ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t i;
+  int32_t root;
+  int32_t input;
+  int32_t k;
+
+  lw_math_ref_begin(stats, &acc);
+
+  lw_math_ref_add(stats, &acc, (double)fn(INT32_MIN) - lw_math_ref_sqrt(INT32_MIN),
+                  INT32_MIN, 0, 0);
+  lw_math_ref_add(stats, &acc, (double)fn(INT32_MAX) - lw_math_ref_sqrt(INT32_MAX),
+                  INT32_MAX, 0, 0);
+
+  /* perfect squares and their neighbours, sparser on the large ones */
+  for (root = 0; root <= 46340; root += (root < 4096) ? 1 : 37) {
+    for (k = -1; k <= 1; k++) {
+      input = (root * root) + k;
+      lw_math_ref_add(stats, &acc, (double)fn(input) - lw_math_ref_sqrt(input),
+                      input, 0, 0);
+    }
+  }
+
+  /* half of the random inputs on the full range, half on small values */
+  for (i = 0u; i < n_random; i++) {
+    input = (int32_t)lw_math_ref_rand(&state);
+    if (0u != (i & 1u)) {
+      input &= 0x000FFFFF;
+    }
+    lw_math_ref_add(stats, &acc, (double)fn(input) - lw_math_ref_sqrt(input),
+                    input, 0, 0);
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks an arctangent implementation on the edge
+ *         cases (every pair of full scale, zero and unit values) and on
+ *         n_random random inputs. Angle errors are wrapped to [-32768, 32768).
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_atan2(atan2_fn_t fn, uint32_t n_random, uint32_t seed,
+                             ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t i;
+  uint32_t j;
+  uint32_t rnd;
+  int16_t x;
+  int16_t y;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < N_EDGE_VALUES; i++) {
+    for (j = 0u; j < N_EDGE_VALUES; j++) {
+      y = edge_values[i];
+      x = edge_values[j];
+      lw_math_ref_add(stats, &acc,
+                      lw_math_ref_wrap((double)fn(y, x) - lw_math_ref_atan2(y, x)),
+                      y, x, 0);
+    }
+  }
+
+  for (i = 0u; i < n_random; i++) {
+    rnd = lw_math_ref_rand(&state);
+    y = (int16_t)(uint16_t)rnd;
+    x = (int16_t)(uint16_t)(rnd >> 16);
+    lw_math_ref_add(stats, &acc,
+                    lw_math_ref_wrap((double)fn(y, x) - lw_math_ref_atan2(y, x)),
+                    y, x, 0);
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a Clarke implementation on the edge cases
+ *         (every pair of full scale, zero and unit values) and on n_random
+ *         random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_clarke(clarke_fn_t fn, uint32_t n_random, uint32_t seed,
+                              ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t i;
+  uint32_t j;
+  uint32_t rnd;
+  ab_t input;
+  alphabeta_t out;
+  alphabeta_ref_t ref;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < (N_EDGE_VALUES + n_random); i++) {
+
+    if (i < N_EDGE_VALUES) {
+      for (j = 0u; j < N_EDGE_VALUES; j++) {
+        input.a = edge_values[i];
+        input.b = edge_values[j];
+        out = fn(input);
+        ref = lw_math_ref_clarke(input);
+        lw_math_ref_add(stats, &acc, (double)out.alpha - ref.alpha, input.a, input.b, 0);
+        lw_math_ref_add(stats, &acc, (double)out.beta - ref.beta, input.a, input.b, 0);
+      }
+    }
+    else {
+      rnd = lw_math_ref_rand(&state);
+      input.a = (int16_t)(uint16_t)rnd;
+      input.b = (int16_t)(uint16_t)(rnd >> 16);
+      out = fn(input);
+      ref = lw_math_ref_clarke(input);
+      lw_math_ref_add(stats, &acc, (double)out.alpha - ref.alpha, input.a, input.b, 0);
+      lw_math_ref_add(stats, &acc, (double)out.beta - ref.beta, input.a, input.b, 0);
+    }
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a Park implementation on the edge cases
+ *         (full scale, zero and unit values on the quadrant boundaries) and
+ *         on n_random random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_park(park_fn_t fn, uint32_t n_random, uint32_t seed,
+                            ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t i;
+  uint32_t j;
+  uint32_t k;
+  uint32_t rnd;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < N_EDGE_VALUES; i++) {
+    for (j = 0u; j < N_EDGE_VALUES; j++) {
+      for (k = 0u; k < N_EDGE_ANGLES; k++) {
+        lw_math_ref_park_one(fn, stats, &acc, edge_values[i], edge_values[j],
+                             edge_angles[k]);
+      }
+    }
+  }
+
+  for (i = 0u; i < n_random; i++) {
+    rnd = lw_math_ref_rand(&state);
+    lw_math_ref_park_one(fn, stats, &acc, (int16_t)(uint16_t)rnd,
+                         (int16_t)(uint16_t)(rnd >> 16),
+                         (int16_t)(uint16_t)lw_math_ref_rand(&state));
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a reverse Park implementation on the edge
+ *         cases (full scale, zero and unit values on the quadrant
+ *         boundaries) and on n_random random inputs
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_rev_park(rev_park_fn_t fn, uint32_t n_random,
+                                uint32_t seed, ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t i;
+  uint32_t j;
+  uint32_t k;
+  uint32_t rnd;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < N_EDGE_VALUES; i++) {
+    for (j = 0u; j < N_EDGE_VALUES; j++) {
+      for (k = 0u; k < N_EDGE_ANGLES; k++) {
+        lw_math_ref_rev_park_one(fn, stats, &acc, edge_values[i], edge_values[j],
+                                 edge_angles[k]);
+      }
+    }
+  }
+
+  for (i = 0u; i < n_random; i++) {
+    rnd = lw_math_ref_rand(&state);
+    lw_math_ref_rev_park_one(fn, stats, &acc, (int16_t)(uint16_t)rnd,
+                             (int16_t)(uint16_t)(rnd >> 16),
+                             (int16_t)(uint16_t)lw_math_ref_rand(&state));
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a multi-frame Park implementation on the
+ *         Park edge cases and on n_random random inputs, each on frames of
+ *         order 1, -1, 2, -2, 5, -5, 7, 11, 13, 127 and -128. Frame k is
+ *         compared with the Park reference at the wrapped angle
+ *         orders[k] * theta.
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_park_multi(park_multi_fn_t fn, uint32_t n_random,
+                                  uint32_t seed, ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t i;
+  uint32_t k;
+  alphabeta_t input;
+  qd_t out[N_ORDERS];
+  qd_ref_t ref;
+  int16_t theta;
+  int16_t angle;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < (N_EDGE_CASES + n_random); i++) {
+    lw_math_ref_sample(i, &state, &input.alpha, &input.beta, &theta);
+    fn(input, theta, multi_orders, out, (uint8_t)N_ORDERS);
+
+    for (k = 0u; k < N_ORDERS; k++) {
+      angle = (int16_t)(uint16_t)((uint32_t)(uint16_t)multi_orders[k] * (uint16_t)theta);
+      ref = lw_math_ref_park(input, angle);
+      lw_math_ref_add(stats, &acc, (double)out[k].q - ref.q, input.alpha,
+                      input.beta, theta);
+      lw_math_ref_add(stats, &acc, (double)out[k].d - ref.d, input.alpha,
+                      input.beta, theta);
+    }
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a structure of arrays Clarke implementation
+ *         on the Clarke edge cases and on n_random random inputs, fed in
+ *         blocks of 256 samples
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_clarke_soa(clarke_soa_fn_t fn, uint32_t n_random,
+                                  uint32_t seed, ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t total = (N_EDGE_VALUES * N_EDGE_VALUES) + n_random;
+  uint32_t i;
+  uint32_t j;
+  uint32_t n;
+  uint32_t rnd;
+  int16_t a[SOA_BLOCK];
+  int16_t b[SOA_BLOCK];
+  int16_t alpha[SOA_BLOCK];
+  int16_t beta[SOA_BLOCK];
+  ab_t input;
+  alphabeta_ref_t ref;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < total; i += n) {
+    n = ((total - i) < SOA_BLOCK) ? (total - i) : SOA_BLOCK;
+
+    for (j = 0u; j < n; j++) {
+      if ((i + j) < (N_EDGE_VALUES * N_EDGE_VALUES)) {
+        a[j] = edge_values[(i + j) / N_EDGE_VALUES];
+        b[j] = edge_values[(i + j) % N_EDGE_VALUES];
+      }
+      else {
+        rnd = lw_math_ref_rand(&state);
+        a[j] = (int16_t)(uint16_t)rnd;
+        b[j] = (int16_t)(uint16_t)(rnd >> 16);
+      }
+    }
+
+    fn(a, b, alpha, beta, n);
+
+    for (j = 0u; j < n; j++) {
+      input.a = a[j];
+      input.b = b[j];
+      ref = lw_math_ref_clarke(input);
+      lw_math_ref_add(stats, &acc, (double)alpha[j] - ref.alpha, a[j], b[j], 0);
+      lw_math_ref_add(stats, &acc, (double)beta[j] - ref.beta, a[j], b[j], 0);
+    }
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a structure of arrays Park implementation
+ *         on the Park edge cases and on n_random random inputs, fed in
+ *         blocks of 256 samples
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_park_soa(park_soa_fn_t fn, uint32_t n_random,
+                                uint32_t seed, ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t total = N_EDGE_CASES + n_random;
+  uint32_t i;
+  uint32_t j;
+  uint32_t n;
+  int16_t alpha[SOA_BLOCK];
+  int16_t beta[SOA_BLOCK];
+  int16_t theta[SOA_BLOCK];
+  int16_t q[SOA_BLOCK];
+  int16_t d[SOA_BLOCK];
+  alphabeta_t input;
+  qd_ref_t ref;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < total; i += n) {
+    n = ((total - i) < SOA_BLOCK) ? (total - i) : SOA_BLOCK;
+
+    for (j = 0u; j < n; j++) {
+      lw_math_ref_sample(i + j, &state, &alpha[j], &beta[j], &theta[j]);
+    }
+
+    fn(alpha, beta, theta, q, d, n);
+
+    for (j = 0u; j < n; j++) {
+      input.alpha = alpha[j];
+      input.beta = beta[j];
+      ref = lw_math_ref_park(input, theta[j]);
+      lw_math_ref_add(stats, &acc, (double)q[j] - ref.q, alpha[j], beta[j], theta[j]);
+      lw_math_ref_add(stats, &acc, (double)d[j] - ref.d, alpha[j], beta[j], theta[j]);
+    }
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  This function checks a structure of arrays reverse Park
+ *         implementation on the reverse Park edge cases and on n_random
+ *         random inputs, fed in blocks of 256 samples
+ * @param  fn: implementation under test
+ * @param  n_random: number of random inputs
+ * @param  seed: seed of the random generator (0 selects a default one)
+ * @param  stats: error statistics
+ */
+void lw_math_ref_check_rev_park_soa(rev_park_soa_fn_t fn, uint32_t n_random,
+                                    uint32_t seed, ref_stats_t *stats) {
+
+  ref_acc_t acc;
+  uint32_t state = (0u != seed) ? seed : DEFAULT_SEED;
+  uint32_t total = N_EDGE_CASES + n_random;
+  uint32_t i;
+  uint32_t j;
+  uint32_t n;
+  int16_t q[SOA_BLOCK];
+  int16_t d[SOA_BLOCK];
+  int16_t theta[SOA_BLOCK];
+  int16_t alpha[SOA_BLOCK];
+  int16_t beta[SOA_BLOCK];
+  qd_t input;
+  alphabeta_ref_t ref;
+
+  lw_math_ref_begin(stats, &acc);
+
+  for (i = 0u; i < total; i += n) {
+    n = ((total - i) < SOA_BLOCK) ? (total - i) : SOA_BLOCK;
+
+    for (j = 0u; j < n; j++) {
+      lw_math_ref_sample(i + j, &state, &q[j], &d[j], &theta[j]);
+    }
+
+    fn(q, d, theta, alpha, beta, n);
+
+    for (j = 0u; j < n; j++) {
+      input.q = q[j];
+      input.d = d[j];
+      ref = lw_math_ref_rev_park(input, theta[j]);
+      lw_math_ref_add(stats, &acc, (double)alpha[j] - ref.alpha, q[j], d[j], theta[j]);
+      lw_math_ref_add(stats, &acc, (double)beta[j] - ref.beta, q[j], d[j], theta[j]);
+    }
+  }
+
+  lw_math_ref_end(stats, &acc);
+}
+
+/**
+ * @brief  Limits a reference value to the range of the saturated outputs
+ * @param  value: value to limit
+ * @retval value limited to [-32767, 32767]
+ */
+static double lw_math_ref_sat(double value) {
+  return (value > REF_SAT) ? REF_SAT : ((value < -REF_SAT) ? -REF_SAT : value);
+}
+
+/**
+ * @brief  Wraps an angle error to a single turn
+ * @param  angle_err: angle error in q1.15 scale
+ * @retval angle error in [-32768, 32768)
+ */
+static double lw_math_ref_wrap(double angle_err) {
+  return angle_err - (2.0 * REF_FULL_SCALE *
+                      floor((angle_err + REF_FULL_SCALE) / (2.0 * REF_FULL_SCALE)));
+}
+
+/**
+ * @brief  xorshift32 pseudo random generator, reproducible on every target
+ * @param  state: generator state, never 0
+ * @retval next random number
+ */
+static uint32_t lw_math_ref_rand(uint32_t *state) {
+
+  uint32_t x = *state;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+
+  return (x);
+}
+
+/**
+ * @brief  Clears the statistics before a check
+ * @param  stats: statistics to clear
+ * @param  acc: running sums to clear
+ */
+static void lw_math_ref_begin(ref_stats_t *stats, ref_acc_t *acc) {
+
+  stats->n = 0u;
+  stats->max_abs_err = -1.0;
+  stats->mean_err = 0.0;
+  stats->mean_abs_err = 0.0;
+  stats->rms_err = 0.0;
+  stats->worst_input[0] = 0;
+  stats->worst_input[1] = 0;
+  stats->worst_input[2] = 0;
+
+  acc->sum = 0.0;
+  acc->sum_abs = 0.0;
+  acc->sum_sq = 0.0;
+}
+
+/**
+ * @brief  Adds one error sample to the statistics
+ * @param  stats: statistics
+ * @param  acc: running sums
+ * @param  err: error of the sample in LSB
+ * @param  in0: first input of the sample
+ * @param  in1: second input of the sample
+ * @param  in2: third input of the sample
+ */
+static void lw_math_ref_add(ref_stats_t *stats, ref_acc_t *acc, double err,
+                            int32_t in0, int32_t in1, int32_t in2) {
+
+  double abs_err = fabs(err);
+
+  stats->n++;
+  acc->sum += err;
+  acc->sum_abs += abs_err;
+  acc->sum_sq += err * err;
+
+  if (abs_err > stats->max_abs_err) {
+    stats->max_abs_err = abs_err;
+    stats->worst_input[0] = in0;
+    stats->worst_input[1] = in1;
+    stats->worst_input[2] = in2;
+  }
+}
+
+/**
+ * @brief  Computes the averages once all the samples are in
+ * @param  stats: statistics
+ * @param  acc: running sums
+ */
+static void lw_math_ref_end(ref_stats_t *stats, const ref_acc_t *acc) {
+
+  if (stats->n > 0u) {
+    stats->mean_err = acc->sum / (double)stats->n;
+    stats->mean_abs_err = acc->sum_abs / (double)stats->n;
+    stats->rms_err = sqrt(acc->sum_sq / (double)stats->n);
+  }
+  else {
+    stats->max_abs_err = 0.0;
+  }
+}
+
+/**
+ * @brief  Compares one Park sample
+ * @param  fn: implementation under test
+ * @param  stats: statistics
+ * @param  acc: running sums
+ * @param  x: alpha component
+ * @param  y: beta component
+ * @param  theta: angle in q1.15 format
+ */
+static void lw_math_ref_park_one(park_fn_t fn, ref_stats_t *stats, ref_acc_t *acc,
+                                 int16_t x, int16_t y, int16_t theta) {
+
+  alphabeta_t input;
+  qd_t out;
+  qd_ref_t ref;
+
+  input.alpha = x;
+  input.beta = y;
+  out = fn(input, theta);
+  ref = lw_math_ref_park(input, theta);
+
+  lw_math_ref_add(stats, acc, (double)out.q - ref.q, x, y, theta);
+  lw_math_ref_add(stats, acc, (double)out.d - ref.d, x, y, theta);
+}
+
+/**
+ * @brief  Compares one reverse Park sample
+ * @param  fn: implementation under test
+ * @param  stats: statistics
+ * @param  acc: running sums
+ * @param  x: q component
+ * @param  y: d component
+ * @param  theta: angle in q1.15 format
+ */
+static void lw_math_ref_rev_park_one(rev_park_fn_t fn, ref_stats_t *stats,
+                                     ref_acc_t *acc, int16_t x, int16_t y,
+                                     int16_t theta) {
+
+  qd_t input;
+  alphabeta_t out;
+  alphabeta_ref_t ref;
+
+  input.q = x;
+  input.d = y;
+  out = fn(input, theta);
+  ref = lw_math_ref_rev_park(input, theta);
+
+  lw_math_ref_add(stats, acc, (double)out.alpha - ref.alpha, x, y, theta);
+  lw_math_ref_add(stats, acc, (double)out.beta - ref.beta, x, y, theta);
+}
+
+/**
+ * @brief  Builds sample i of a two component and angle check: the edge
+ *         cases first, in the order of lw_math_ref_check_park, then random
+ *         values drawn as in lw_math_ref_check_park
+ * @param  i: sample index
+ * @param  state: random generator state
+ * @param  x: first component
+ * @param  y: second component
+ * @param  theta: angle in q1.15 format
+ */
+static void lw_math_ref_sample(uint32_t i, uint32_t *state, int16_t *x,
+                               int16_t *y, int16_t *theta) {
+
+  uint32_t rnd;
+
+  if (i < N_EDGE_CASES) {
+    *x = edge_values[i / (N_EDGE_VALUES * N_EDGE_ANGLES)];
+    *y = edge_values[(i / N_EDGE_ANGLES) % N_EDGE_VALUES];
+    *theta = edge_angles[i % N_EDGE_ANGLES];
+  }
+  else {
+    rnd = lw_math_ref_rand(state);
+    *x = (int16_t)(uint16_t)rnd;
+    *y = (int16_t)(uint16_t)(rnd >> 16);
+    *theta = (int16_t)(uint16_t)lw_math_ref_rand(state);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
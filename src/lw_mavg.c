@@ -0,0 +1,322 @@
+/******************************************************************************
+ * Filename              :   lw_mavg.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_mavg.c
+ *  @brief This module handles moving averages and moving RMS values with
+ *         O(1) updates
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_mavg.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static uint16_t lw_mavg_next(uint16_t pos, uint16_t len);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a moving average with a cleared window
+ * @param  mavg: moving average to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mavg_init(mavg_t *mavg, int16_t *hist, int32_t *sum, uint16_t len,
+                  uint32_t n) {
+
+  uint32_t i;
+
+  mavg->hist = hist;
+  mavg->sum = sum;
+  mavg->len = (len > 0u) ? len : 1u;
+  mavg->pos = 0u;
+  mavg->n = n;
+
+  for (i = 0u; i < ((uint32_t)mavg->len * n); i++) {
+    hist[i] = 0;
+  }
+  for (i = 0u; i < n; i++) {
+    sum[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function pushes one sample per channel in the window. The
+ *         loop has no data dependent branches and vectorizes across the
+ *         channels.
+ * @param  mavg: moving average
+ * @param  input: array of n samples
+ */
+void lw_mavg_update(mavg_t *mavg, const int16_t *input) {
+
+  int16_t *slot = &mavg->hist[(uint32_t)mavg->pos * mavg->n];
+  int32_t *sum = mavg->sum;
+  uint32_t n = mavg->n;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    sum[i] += (int32_t)input[i] - (int32_t)slot[i];
+    slot[i] = input[i];
+  }
+
+  mavg->pos = lw_mavg_next(mavg->pos, mavg->len);
+}
+
+/**
+ * @brief  This function returns the average of one channel
+ * @param  mavg: moving average
+ * @param  ch: channel index
+ * @retval average of the window, truncated toward zero
+ */
+int16_t lw_mavg_get(const mavg_t *mavg, uint32_t ch) {
+  return ((int16_t)(mavg->sum[ch] / (int32_t)mavg->len));
+}
+
+/**
+ * @brief  This function initializes a moving RMS with a cleared window
+ * @param  mrms: moving RMS to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum_sq: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mrms_init(mrms_t *mrms, int16_t *hist, int64_t *sum_sq, uint16_t len,
+                  uint32_t n) {
+
+  uint32_t i;
+
+  mrms->hist = hist;
+  mrms->sum_sq = sum_sq;
+  mrms->len = (len > 0u) ? len : 1u;
+  mrms->pos = 0u;
+  mrms->n = n;
+
+  for (i = 0u; i < ((uint32_t)mrms->len * n); i++) {
+    hist[i] = 0;
+  }
+  for (i = 0u; i < n; i++) {
+    sum_sq[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function pushes one sample per channel in the window
+ * @param  mrms: moving RMS
+ * @param  input: array of n samples
+ */
+void lw_mrms_update(mrms_t *mrms, const int16_t *input) {
+
+  int16_t *slot = &mrms->hist[(uint32_t)mrms->pos * mrms->n];
+  int64_t *sum_sq = mrms->sum_sq;
+  uint32_t n = mrms->n;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    /* x*x - y*y = (x - y)*(x + y) keeps the difference in an int32 */
+    sum_sq[i] += ((int32_t)input[i] - (int32_t)slot[i]) *
+                 ((int32_t)input[i] + (int32_t)slot[i]);
+    slot[i] = input[i];
+  }
+
+  mrms->pos = lw_mavg_next(mrms->pos, mrms->len);
+}
+
+/**
+ * @brief  This function returns the RMS value of one channel. The square
+ *         root (lw_math_sqrt) only runs here, not in the update.
+ * @param  mrms: moving RMS
+ * @param  ch: channel index
+ * @retval RMS value of the window in q1.15 format
+ */
+int16_t lw_mrms_get(const mrms_t *mrms, uint32_t ch) {
+
+  /* the mean square is at most 2^30, a valid lw_math_sqrt input */
+  int32_t mean_sq = (int32_t)(mrms->sum_sq[ch] / (int64_t)mrms->len);
+
+  return ((int16_t)LIMIT(lw_math_sqrt(mean_sq), 0, INT16_MAX));
+}
+
+/**
+ * @brief  This function initializes a fix_t moving average with a cleared
+ *         window
+ * @param  mavg: moving average to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mavg_fix_init(mavg_fix_t *mavg, fix_t *hist, int64_t *sum, uint16_t len,
+                      uint32_t n) {
+
+  uint32_t i;
+
+  mavg->hist = hist;
+  mavg->sum = sum;
+  mavg->len = (len > 0u) ? len : 1u;
+  mavg->pos = 0u;
+  mavg->n = n;
+
+  for (i = 0u; i < ((uint32_t)mavg->len * n); i++) {
+    hist[i] = 0;
+  }
+  for (i = 0u; i < n; i++) {
+    sum[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function pushes one sample per channel in the window
+ * @param  mavg: moving average
+ * @param  input: array of n samples
+ */
+void lw_mavg_fix_update(mavg_fix_t *mavg, const fix_t *input) {
+
+  fix_t *slot = &mavg->hist[(uint32_t)mavg->pos * mavg->n];
+  int64_t *sum = mavg->sum;
+  uint32_t n = mavg->n;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    sum[i] += (int64_t)input[i] - (int64_t)slot[i];
+    slot[i] = input[i];
+  }
+
+  mavg->pos = lw_mavg_next(mavg->pos, mavg->len);
+}
+
+/**
+ * @brief  This function returns the average of one channel
+ * @param  mavg: moving average
+ * @param  ch: channel index
+ * @retval average of the window, truncated toward zero
+ */
+fix_t lw_mavg_fix_get(const mavg_fix_t *mavg, uint32_t ch) {
+  return ((fix_t)(mavg->sum[ch] / (int64_t)mavg->len));
+}
+
+/**
+ * @brief  This function initializes a fix_t moving RMS with a cleared window
+ * @param  mrms: moving RMS to initialize
+ * @param  hist: array of len * n samples, owned by the caller
+ * @param  sum_sq: array of n sums, owned by the caller
+ * @param  len: window length (> 0)
+ * @param  n: number of channels
+ */
+void lw_mrms_fix_init(mrms_fix_t *mrms, fix_t *hist, int64_t *sum_sq,
+                      uint16_t len, uint32_t n) {
+
+  uint32_t i;
+
+  mrms->hist = hist;
+  mrms->sum_sq = sum_sq;
+  mrms->len = (len > 0u) ? len : 1u;
+  mrms->pos = 0u;
+  mrms->shift = 0u;
+  mrms->n = n;
+
+  /* len squares of at most 2^62 shifted by ceil(log2(len)) fit an int64 */
+  while (((uint32_t)1 << mrms->shift) < mrms->len) {
+    mrms->shift++;
+  }
+
+  for (i = 0u; i < ((uint32_t)mrms->len * n); i++) {
+    hist[i] = 0;
+  }
+  for (i = 0u; i < n; i++) {
+    sum_sq[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function pushes one sample per channel in the window. The
+ *         sum of squares fits an int64 for any input.
+ * @param  mrms: moving RMS
+ * @param  input: array of n samples in q format
+ */
+void lw_mrms_fix_update(mrms_fix_t *mrms, const fix_t *input) {
+
+  fix_t *slot = &mrms->hist[(uint32_t)mrms->pos * mrms->n];
+  int64_t *sum_sq = mrms->sum_sq;
+  uint32_t n = mrms->n;
+  uint8_t shift = mrms->shift;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    sum_sq[i] += (((int64_t)input[i] * input[i]) >> shift) -
+                 (((int64_t)slot[i] * slot[i]) >> shift);
+    slot[i] = input[i];
+  }
+
+  mrms->pos = lw_mavg_next(mrms->pos, mrms->len);
+}
+
+/**
+ * @brief  This function returns the RMS value of one channel with
+ *         lw_math_sqrt. Mean squares too large for its int32 input are
+ *         scaled down by powers of 4 first, losing the same number of low
+ *         bits of the result.
+ * @param  mrms: moving RMS
+ * @param  ch: channel index
+ * @retval RMS value of the window in q format
+ */
+fix_t lw_mrms_fix_get(const mrms_fix_t *mrms, uint32_t ch) {
+
+  /* mean square in q2q format, at most 2^62: the quotient and the
+   * remainder are scaled back separately to keep the low bits */
+  int64_t sum = mrms->sum_sq[ch];
+  int64_t len = (int64_t)mrms->len;
+  int64_t square = ((sum / len) * ((int64_t)1 << mrms->shift)) +
+                   (((sum % len) * ((int64_t)1 << mrms->shift)) / len);
+  uint8_t shift = 0u;
+
+  while (square > (int64_t)INT32_MAX) {
+    square >>= 2;
+    shift++;
+  }
+
+  return ((fix_t)(lw_math_sqrt((int32_t)square) << shift));
+}
+
+/**
+ * @brief  Advances a window slot
+ * @param  pos: current slot
+ * @param  len: window length
+ * @retval next slot
+ */
+static uint16_t lw_mavg_next(uint16_t pos, uint16_t len) {
+  return ((uint16_t)(((uint32_t)pos + 1u < len) ? (pos + 1u) : 0u));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
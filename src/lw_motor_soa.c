@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Filename              :   lw_motor_soa.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_motor_soa.c
+ *  @brief This module handles the structure of arrays motor state container
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include "lw_motor_soa.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/* motor of the k-th element of an optional index list */
+#define MOTOR_INDEX(index, k) ((NULL != (index)) ? (index)[k] : (k))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function lays the columns of n motors out in the memory
+ *         provided and clears them
+ * @param  motors: container to initialize
+ * @param  mem: memory of at least LW_MOTOR_SOA_MEM_SIZE(n) bytes, any alignment
+ * @param  size: size of mem in bytes
+ * @param  n: number of motors
+ * @retval 0 on success, EINVAL if the memory is too small
+ */
+int lw_motor_soa_init(motor_soa_t *motors, void *mem, size_t size, uint32_t n) {
+
+  uintptr_t base;
+  int16_t *column;
+  int16_t **columns[LW_MOTOR_SOA_COLUMNS];
+  uint32_t stride = LW_MOTOR_SOA_STRIDE(n);
+  uint32_t i;
+  uint32_t j;
+
+  if ((NULL == mem) || (size < LW_MOTOR_SOA_MEM_SIZE(n))) {
+    return (EINVAL);
+  }
+
+  columns[0] = &motors->i_a;
+  columns[1] = &motors->i_b;
+  columns[2] = &motors->theta;
+  columns[3] = &motors->cos;
+  columns[4] = &motors->sin;
+  columns[5] = &motors->i_alpha;
+  columns[6] = &motors->i_beta;
+  columns[7] = &motors->i_q;
+  columns[8] = &motors->i_d;
+  columns[9] = &motors->v_q;
+  columns[10] = &motors->v_d;
+  columns[11] = &motors->v_alpha;
+  columns[12] = &motors->v_beta;
+
+  base = ((uintptr_t)mem + (LW_MOTOR_SOA_ALIGN - 1u)) &
+         ~(uintptr_t)(LW_MOTOR_SOA_ALIGN - 1u);
+  column = (int16_t *)base;
+
+  /* stride is a whole number of cache lines, so every column stays aligned */
+  for (i = 0u; i < LW_MOTOR_SOA_COLUMNS; i++) {
+    *columns[i] = column;
+    for (j = 0u; j < stride; j++) {
+      column[j] = 0;
+    }
+    column += stride;
+  }
+
+  motors->n = n;
+  motors->stride = stride;
+
+  return (0);
+}
+
+/**
+ * @brief  This function fills the cos and sin columns from theta
+ * @param  motors: container
+ * @param  first: first motor
+ * @param  count: number of motors
+ */
+void lw_motor_soa_update_trig(motor_soa_t *motors, uint32_t first, uint32_t count) {
+
+  uint32_t i;
+  trig_components_t Local_Vector_Components;
+
+  for (i = first; i < (first + count); i++) {
+    Local_Vector_Components = lw_math_trig_functions(motors->theta[i]);
+    motors->cos[i] = Local_Vector_Components.cos;
+    motors->sin[i] = Local_Vector_Components.sin;
+  }
+}
+
+/**
+ * @brief  This function copies phase currents into the container
+ * @param  motors: container
+ * @param  src: array of count phase currents in ab_t format
+ * @param  index: motor of each element of src, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_gather_i_ab(motor_soa_t *motors, const ab_t *src,
+                              const uint32_t *index, uint32_t count) {
+
+  uint32_t k;
+  uint32_t i;
+
+  for (k = 0u; k < count; k++) {
+    i = MOTOR_INDEX(index, k);
+    motors->i_a[i] = src[k].a;
+    motors->i_b[i] = src[k].b;
+  }
+}
+
+/**
+ * @brief  This function copies voltage commands into the container
+ * @param  motors: container
+ * @param  src: array of count voltage commands in qd_t format
+ * @param  index: motor of each element of src, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_gather_v_qd(motor_soa_t *motors, const qd_t *src,
+                              const uint32_t *index, uint32_t count) {
+
+  uint32_t k;
+  uint32_t i;
+
+  for (k = 0u; k < count; k++) {
+    i = MOTOR_INDEX(index, k);
+    motors->v_q[i] = src[k].q;
+    motors->v_d[i] = src[k].d;
+  }
+}
+
+/**
+ * @brief  This function copies currents alpha and beta out of the container
+ * @param  motors: container
+ * @param  dst: array of count currents in alphabeta_t format
+ * @param  index: motor of each element of dst, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_scatter_i_alphabeta(const motor_soa_t *motors, alphabeta_t *dst,
+                                      const uint32_t *index, uint32_t count) {
+
+  uint32_t k;
+  uint32_t i;
+
+  for (k = 0u; k < count; k++) {
+    i = MOTOR_INDEX(index, k);
+    dst[k].alpha = motors->i_alpha[i];
+    dst[k].beta = motors->i_beta[i];
+  }
+}
+
+/**
+ * @brief  This function copies currents q and d out of the container
+ * @param  motors: container
+ * @param  dst: array of count currents in qd_t format
+ * @param  index: motor of each element of dst, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_scatter_i_qd(const motor_soa_t *motors, qd_t *dst,
+                               const uint32_t *index, uint32_t count) {
+
+  uint32_t k;
+  uint32_t i;
+
+  for (k = 0u; k < count; k++) {
+    i = MOTOR_INDEX(index, k);
+    dst[k].q = motors->i_q[i];
+    dst[k].d = motors->i_d[i];
+  }
+}
+
+/**
+ * @brief  This function copies voltage commands alpha and beta out of the
+ *         container
+ * @param  motors: container
+ * @param  dst: array of count voltages in alphabeta_t format
+ * @param  index: motor of each element of dst, or NULL for motors 0 to count-1
+ * @param  count: number of elements
+ */
+void lw_motor_soa_scatter_v_alphabeta(const motor_soa_t *motors, alphabeta_t *dst,
+                                      const uint32_t *index, uint32_t count) {
+
+  uint32_t k;
+  uint32_t i;
+
+  for (k = 0u; k < count; k++) {
+    i = MOTOR_INDEX(index, k);
+    dst[k].alpha = motors->v_alpha[i];
+    dst[k].beta = motors->v_beta[i];
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,197 @@
+/******************************************************************************
+ * Filename              :   lw_pi.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pi.c
+ *  @brief This module handles the proportional-integral controllers in
+ *         fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_pi.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/* an output value in the q.shift format of the integrator */
+#define PI_SCALE(x, shift) ((int64_t)(x) * ((int64_t)1 << (shift)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a PI controller with clamping
+ *         anti-windup and a cleared integrator
+ * @param  pi: controller to initialize
+ * @param  kp: proportional gain in q.kp_shift format
+ * @param  kp_shift: fractional bits of kp (0 to 15)
+ * @param  ki: integral gain in q.ki_shift format
+ * @param  ki_shift: fractional bits of ki (0 to 30)
+ * @param  out_min: lower output limit
+ * @param  out_max: upper output limit
+ */
+void lw_pi_init(pi_t *pi, int16_t kp, uint8_t kp_shift, int16_t ki,
+                uint8_t ki_shift, int16_t out_min, int16_t out_max) {
+  pi->kp = kp;
+  pi->kp_shift = kp_shift;
+  pi->ki = ki;
+  pi->ki_shift = ki_shift;
+  pi->kb = 0;
+  pi->out_min = out_min;
+  pi->out_max = out_max;
+  pi->aw = PI_AW_CLAMP;
+  pi->integral = 0;
+}
+
+/**
+ * @brief  This function selects back-calculation anti-windup
+ * @param  pi: controller
+ * @param  kb: back-calculation gain in q1.15 format, usually ki/kp scaled
+ */
+void lw_pi_set_back_calc(pi_t *pi, int16_t kb) {
+  pi->kb = kb;
+  pi->aw = PI_AW_BACK_CALC;
+}
+
+/**
+ * @brief  This function presets the integral term, for instance to start
+ *         from a known output
+ * @param  pi: controller
+ * @param  value: integral term in output units
+ */
+void lw_pi_set_integral(pi_t *pi, int16_t value) {
+  pi->integral = PI_SCALE(value, pi->ki_shift);
+}
+
+/**
+ * @brief  This function runs one step of a PI controller
+ * @param  pi: controller
+ * @param  error: reference minus feedback
+ * @retval controller output within [out_min, out_max]
+ */
+int16_t lw_pi_step(pi_t *pi, int16_t error) {
+
+  int32_t span = (int32_t)pi->out_max - (int32_t)pi->out_min;
+  int32_t wide = (PI_AW_BACK_CALC == pi->aw) ? span : 0;
+  int64_t lo = PI_SCALE((int32_t)pi->out_min - wide, pi->ki_shift);
+  int64_t hi = PI_SCALE((int32_t)pi->out_max + wide, pi->ki_shift);
+  int32_t prop;
+  int64_t output;
+  int64_t limited;
+  int64_t excess;
+
+  prop = ((int32_t)pi->kp * (int32_t)error) >> pi->kp_shift;
+  pi->integral += (int64_t)pi->ki * (int64_t)error;
+  pi->integral = LIMIT(pi->integral, lo, hi);
+
+  output = (int64_t)prop + (pi->integral >> pi->ki_shift);
+  limited = LIMIT(output, (int64_t)pi->out_min, (int64_t)pi->out_max);
+
+  if (PI_AW_BACK_CALC == pi->aw) {
+    /* bleed the part of the output the actuator could not follow. The
+     * excess is limited to the output span, so excess * kb fits 32 bits
+     * and the product with 2^ki_shift stays below 2^62. */
+    excess = LIMIT(limited - output, -(int64_t)span, (int64_t)span);
+    pi->integral += PI_SCALE(excess * pi->kb, pi->ki_shift) >> 15;
+    pi->integral = LIMIT(pi->integral, lo, hi);
+  }
+
+  return ((int16_t)limited);
+}
+
+/**
+ * @brief  This function runs the q and d current controllers
+ * @param  pi_q: q axis controller
+ * @param  pi_d: d axis controller
+ * @param  ref: references in qd_t format
+ * @param  meas: feedbacks in qd_t format
+ * @retval controller outputs in qd_t format
+ */
+qd_t lw_pi_step_qd(pi_t *pi_q, pi_t *pi_d, qd_t ref, qd_t meas) {
+
+  qd_t output;
+  int32_t err_q = LIMIT((int32_t)ref.q - (int32_t)meas.q, -INT16_MAX, INT16_MAX);
+  int32_t err_d = LIMIT((int32_t)ref.d - (int32_t)meas.d, -INT16_MAX, INT16_MAX);
+
+  output.q = lw_pi_step(pi_q, (int16_t)err_q);
+  output.d = lw_pi_step(pi_d, (int16_t)err_d);
+
+  return (output);
+}
+
+/**
+ * @brief  This function clears the integrators of a bank
+ * @param  bank: bank of controllers, arrays already assigned
+ */
+void lw_pi_bank_reset(pi_bank_t *bank) {
+
+  uint32_t i;
+
+  for (i = 0u; i < bank->n; i++) {
+    bank->integral[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function runs one step of every controller of a bank. The
+ *         loop has no data dependent branches, so it vectorizes across the
+ *         controllers.
+ * @param  bank: bank of controllers
+ * @param  error: array of n errors
+ * @param  output: array of n outputs
+ */
+void lw_pi_bank_step(pi_bank_t *bank, const int16_t *error, int16_t *output) {
+
+  const int16_t *kp = bank->kp;
+  const int16_t *ki = bank->ki;
+  const int16_t *out_min = bank->out_min;
+  const int16_t *out_max = bank->out_max;
+  int64_t *integral = bank->integral;
+  uint8_t kp_shift = bank->kp_shift;
+  uint8_t ki_shift = bank->ki_shift;
+  uint32_t i;
+  int64_t acc;
+  int64_t lo;
+  int64_t hi;
+  int64_t out;
+
+  for (i = 0u; i < bank->n; i++) {
+    lo = PI_SCALE(out_min[i], ki_shift);
+    hi = PI_SCALE(out_max[i], ki_shift);
+    acc = integral[i] + ((int64_t)ki[i] * (int64_t)error[i]);
+    acc = LIMIT(acc, lo, hi);
+    integral[i] = acc;
+
+    out = (int64_t)(((int32_t)kp[i] * (int32_t)error[i]) >> kp_shift) + (acc >> ki_shift);
+    output[i] = (int16_t)LIMIT(out, (int64_t)out_min[i], (int64_t)out_max[i]);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Filename              :   lw_pid.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pid.c
+ *  @brief This module handles the PID controllers in fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_pid.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function computes the coefficients of a PID from its
+ *         continuous time gains. It is meant to run offline or at start-up,
+ *         the update path only uses the precomputed values.
+ * @param  coef: coefficients to compute
+ * @param  kp: proportional gain
+ * @param  ki: integral gain in 1/s
+ * @param  kd: derivative gain in s
+ * @param  tf: derivative filter time constant in s
+ * @param  ts: sample time in s
+ * @param  b: setpoint weight of the proportional term (usually 0 to 1)
+ * @param  c: setpoint weight of the derivative term (usually 0)
+ * @param  q: q format of the coefficients
+ */
+void lw_pid_design(pid_coef_t *coef, double kp, double ki, double kd, double tf,
+                   double ts, double b, double c, uint32_t q) {
+  coef->kp = FLT2FIX(kp, q);
+  coef->ki = FLT2FIX(ki * ts, q);
+  coef->ad = FLT2FIX(tf / (tf + ts), q);
+  coef->bd = FLT2FIX(kd / (tf + ts), q);
+  coef->b = FLT2FIX(b, q);
+  coef->c = FLT2FIX(c, q);
+}
+
+/**
+ * @brief  This function initializes a PID controller in automatic mode
+ * @param  pid: controller to initialize
+ * @param  coef: coefficients in q format
+ * @param  q: q format of coefficients and signals
+ * @param  out_min: lower output limit in q format
+ * @param  out_max: upper output limit in q format
+ */
+void lw_pid_init(pid_ctrl_t *pid, const pid_coef_t *coef, uint32_t q, fix_t out_min,
+                 fix_t out_max) {
+  pid->coef = *coef;
+  pid->q = q;
+  pid->out_min = out_min;
+  pid->out_max = out_max;
+  pid->integral = 0;
+  pid->deriv = 0;
+  pid->prev_ed = 0;
+  pid->manual = 0u;
+  pid->u_manual = 0;
+}
+
+/**
+ * @brief  This function switches a controller to manual mode; the output
+ *         follows u_manual and the integral term tracks it, so that the
+ *         return to automatic mode is bumpless
+ * @param  pid: controller
+ * @param  u_manual: manual output in q format
+ */
+void lw_pid_set_manual(pid_ctrl_t *pid, fix_t u_manual) {
+  pid->manual = 1u;
+  pid->u_manual = u_manual;
+}
+
+/**
+ * @brief  This function switches a controller back to automatic mode
+ * @param  pid: controller
+ */
+void lw_pid_set_auto(pid_ctrl_t *pid) {
+  pid->manual = 0u;
+}
+
+/**
+ * @brief  This function runs one step of a PID controller
+ * @param  pid: controller
+ * @param  ref: reference in q format
+ * @param  meas: feedback in q format
+ * @retval controller output within [out_min, out_max]
+ */
+fix_t lw_pid_step(pid_ctrl_t *pid, fix_t ref, fix_t meas) {
+
+  const pid_coef_t *k = &pid->coef;
+  uint32_t q = pid->q;
+  fix_t prop;
+  fix_t ed;
+  int64_t output;
+
+  /* derivative on the weighted error, low-pass filtered */
+  ed = FSUB(FMUL(k->c, ref, q), meas);
+  pid->deriv = FADD(FMUL(k->ad, pid->deriv, q), FMUL(k->bd, FSUB(ed, pid->prev_ed), q));
+  pid->prev_ed = ed;
+
+  prop = FMUL(k->kp, FSUB(FMUL(k->b, ref, q), meas), q);
+
+  if (0u == pid->manual) {
+    pid->integral = (fix_t)LIMIT((int64_t)pid->integral +
+                                 (int64_t)FMUL(k->ki, FSUB(ref, meas), q),
+                                 (int64_t)pid->out_min, (int64_t)pid->out_max);
+    output = (int64_t)prop + (int64_t)pid->integral + (int64_t)pid->deriv;
+    output = LIMIT(output, (int64_t)pid->out_min, (int64_t)pid->out_max);
+  }
+  else {
+    /* track the manual output so that the switch back is bumpless */
+    output = LIMIT((int64_t)pid->u_manual, (int64_t)pid->out_min, (int64_t)pid->out_max);
+    pid->integral = (fix_t)LIMIT(output - (int64_t)prop - (int64_t)pid->deriv,
+                                 (int64_t)pid->out_min, (int64_t)pid->out_max);
+  }
+
+  return ((fix_t)output);
+}
+
+/**
+ * @brief  This function initializes every controller of a bank in automatic
+ *         mode with the same coefficients and limits and cleared states;
+ *         single controllers can be retuned in the arrays afterwards
+ * @param  bank: bank of controllers, arrays and n already assigned
+ * @param  coef: coefficients in q format
+ * @param  q: q format of coefficients and signals
+ * @param  out_min: lower output limit in q format
+ * @param  out_max: upper output limit in q format
+ */
+void lw_pid_bank_init(pid_bank_t *bank, const pid_coef_t *coef, uint32_t q,
+                      fix_t out_min, fix_t out_max) {
+
+  uint32_t i;
+
+  bank->q = q;
+
+  for (i = 0u; i < bank->n; i++) {
+    bank->kp[i] = coef->kp;
+    bank->ki[i] = coef->ki;
+    bank->ad[i] = coef->ad;
+    bank->bd[i] = coef->bd;
+    bank->b[i] = coef->b;
+    bank->c[i] = coef->c;
+    bank->out_min[i] = out_min;
+    bank->out_max[i] = out_max;
+    bank->manual[i] = 0u;
+    bank->u_manual[i] = 0;
+  }
+
+  lw_pid_bank_reset(bank);
+}
+
+/**
+ * @brief  This function clears the integral terms, the filtered derivative
+ *         terms and the previous derivative errors of a bank; coefficients,
+ *         limits and modes are kept
+ * @param  bank: bank of controllers, arrays already assigned
+ */
+void lw_pid_bank_reset(pid_bank_t *bank) {
+
+  uint32_t i;
+
+  for (i = 0u; i < bank->n; i++) {
+    bank->integral[i] = 0;
+    bank->deriv[i] = 0;
+    bank->prev_ed[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function runs one step of every controller of a bank, with
+ *         the same arithmetic as lw_pid_step. Mode selection is branchless,
+ *         so the loop vectorizes across the controllers.
+ * @param  bank: bank of controllers
+ * @param  ref: array of n references
+ * @param  meas: array of n feedbacks
+ * @param  output: array of n outputs
+ */
+void lw_pid_bank_step(pid_bank_t *bank, const fix_t *ref, const fix_t *meas,
+                      fix_t *output) {
+
+  uint32_t q = bank->q;
+  uint32_t i;
+  fix_t prop;
+  fix_t ed;
+  fix_t deriv;
+  int64_t lo;
+  int64_t hi;
+  int64_t integ_auto;
+  int64_t out_auto;
+  int64_t out_man;
+  int64_t integ_man;
+
+  for (i = 0u; i < bank->n; i++) {
+    lo = (int64_t)bank->out_min[i];
+    hi = (int64_t)bank->out_max[i];
+
+    ed = FSUB(FMUL(bank->c[i], ref[i], q), meas[i]);
+    deriv = FADD(FMUL(bank->ad[i], bank->deriv[i], q),
+                 FMUL(bank->bd[i], FSUB(ed, bank->prev_ed[i]), q));
+    bank->deriv[i] = deriv;
+    bank->prev_ed[i] = ed;
+
+    prop = FMUL(bank->kp[i], FSUB(FMUL(bank->b[i], ref[i], q), meas[i]), q);
+
+    integ_auto = LIMIT((int64_t)bank->integral[i] +
+                       (int64_t)FMUL(bank->ki[i], FSUB(ref[i], meas[i]), q), lo, hi);
+    out_auto = LIMIT((int64_t)prop + integ_auto + (int64_t)deriv, lo, hi);
+
+    out_man = LIMIT((int64_t)bank->u_manual[i], lo, hi);
+    integ_man = LIMIT(out_man - (int64_t)prop - (int64_t)deriv, lo, hi);
+
+    bank->integral[i] = (fix_t)((0u != bank->manual[i]) ? integ_man : integ_auto);
+    output[i] = (fix_t)((0u != bank->manual[i]) ? out_man : out_auto);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
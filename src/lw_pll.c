@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Filename              :   lw_pll.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pll.c
+ *  @brief This module handles the angle and speed phase locked loop in
+ *         fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_pll.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a phase locked loop. Loop gains scale
+ *         with the amplitude of the input vector.
+ * @param  pll: loop to initialize
+ * @param  kp: proportional gain in q.kp_shift format
+ * @param  kp_shift: fractional bits of kp
+ * @param  ki: integral gain in q.ki_shift format
+ * @param  ki_shift: fractional bits of ki
+ * @param  speed_max: speed limit, same unit as the speed output
+ * @param  speed_shift: fractional bits of the speed in angle LSB per sample
+ *         (0 to 16); 4 gives 1/16 LSB resolution up to 2048 LSB per sample
+ */
+void lw_pll_init(pll_t *pll, int16_t kp, uint8_t kp_shift, int16_t ki,
+                 uint8_t ki_shift, int16_t speed_max, uint8_t speed_shift) {
+  lw_pi_init(&pll->pi, kp, kp_shift, ki, ki_shift, (int16_t)-speed_max, speed_max);
+  pll->speed_shift = speed_shift;
+  lw_pll_reset(pll, 0, 0);
+}
+
+/**
+ * @brief  This function presets the angle and the speed of a loop
+ * @param  pll: loop
+ * @param  theta: angle in q1.15 format
+ * @param  speed: speed, same unit as the speed output
+ */
+void lw_pll_reset(pll_t *pll, int16_t theta, int16_t speed) {
+  pll->phase = (uint32_t)(uint16_t)theta << 16;
+  pll->theta = theta;
+  pll->speed = speed;
+  lw_pi_set_integral(&pll->pi, speed);
+}
+
+/**
+ * @brief  This function runs one step of the loop. The estimated angle
+ *         locks on the input vector, so that lw_math_park(input, theta)
+ *         has its whole amplitude on q.
+ * @param  pll: loop
+ * @param  input: components alpha and beta in alphabeta_t format
+ * @retval estimated angle for the next sample in q1.15 format
+ */
+int16_t lw_pll_step(pll_t *pll, alphabeta_t input) {
+
+  qd_t error;
+
+  /* d is -|v|*sin(theta - estimate), zero once locked */
+  error = lw_math_park(input, pll->theta);
+  pll->speed = lw_pi_step(&pll->pi, (int16_t)-error.d);
+
+  pll->phase += (uint32_t)((int32_t)pll->speed * ((int32_t)1 << (16u - pll->speed_shift)));
+  pll->theta = (int16_t)(uint16_t)(pll->phase >> 16);
+
+  return (pll->theta);
+}
+
+/**
+ * @brief  This function runs one step of several loops, one for each motor
+ * @param  pll: array of n loops
+ * @param  input: array of n alpha-beta vectors
+ * @param  n: number of loops
+ */
+void lw_pll_step_batch(pll_t *pll, const alphabeta_t *input, uint16_t n) {
+
+  uint16_t i;
+
+  for (i = 0u; i < n; i++) {
+    (void)lw_pll_step(&pll[i], input[i]);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,203 @@
+/******************************************************************************
+ * Filename              :   lw_ramp.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_ramp.c
+ *  @brief This module handles the bank of ramp generators
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include "lw_ramp.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define RAMP_RATE_MAX    ((int32_t)0x3FFFFFFF)   /* 2^30 - 1 */
+#define RAMP_VALUE_MIN   ((int32_t)INT16_MIN * 32768)
+#define RAMP_VALUE_MAX   ((int32_t)INT16_MAX * 32768)
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function converts a slope to an increment per step. It is
+ *         meant to run offline or at start-up.
+ * @param  slope: slope in full scale per second (per second^2 for an
+ *         acceleration, with fs squared)
+ * @param  fs: step frequency in Hz
+ * @retval increment per step in q2.30 format, in [1, 2^30 - 1]
+ */
+int32_t lw_ramp_rate(double slope, double fs) {
+
+  double rate = ((slope / fs) * 1073741824.0) + 0.5;
+
+  return ((int32_t)LIMIT(rate, 1.0, (double)RAMP_RATE_MAX));
+}
+
+/**
+ * @brief  This function initializes a bank of ramps with cleared outputs
+ *         and linear ramps of null rate
+ * @param  bank: bank of ramps
+ * @param  rate: array of n rates, owned by the caller
+ * @param  accel: array of n accelerations, owned by the caller
+ * @param  value: array of n outputs, owned by the caller
+ * @param  speed: array of n speeds, owned by the caller
+ * @param  n: number of axes
+ */
+void lw_ramp_bank_init(ramp_bank_t *bank, int32_t *rate, int32_t *accel,
+                       int32_t *value, int32_t *speed, uint32_t n) {
+
+  uint32_t i;
+
+  bank->rate = rate;
+  bank->accel = accel;
+  bank->value = value;
+  bank->speed = speed;
+  bank->n = n;
+
+  for (i = 0u; i < n; i++) {
+    rate[i] = 0;
+    accel[i] = 0;
+  }
+
+  lw_ramp_bank_reset(bank, NULL);
+}
+
+/**
+ * @brief  This function configures one axis of a bank
+ * @param  bank: bank of ramps
+ * @param  axis: axis index
+ * @param  rate: largest speed from lw_ramp_rate
+ * @param  accel: largest speed change from lw_ramp_rate, 0 for a linear
+ *         ramp, limited to rate
+ */
+void lw_ramp_bank_set(ramp_bank_t *bank, uint32_t axis, int32_t rate,
+                      int32_t accel) {
+
+  rate = LIMIT(rate, 0, RAMP_RATE_MAX);
+  accel = LIMIT(accel, 0, rate);
+
+  bank->rate[axis] = rate;
+  bank->accel[axis] = accel;
+}
+
+/**
+ * @brief  This function sets the output of every axis of a bank and stops
+ *         them
+ * @param  bank: bank of ramps
+ * @param  value: array of n initial outputs, NULL to clear them
+ */
+void lw_ramp_bank_reset(ramp_bank_t *bank, const int16_t *value) {
+
+  uint32_t i;
+
+  for (i = 0u; i < bank->n; i++) {
+    bank->value[i] = (NULL != value) ? ((int32_t)value[i] * 32768) : 0;
+    bank->speed[i] = 0;
+  }
+}
+
+/**
+ * @brief  This function runs one step of every ramp of a bank. The loop
+ *         has no data dependent branches, so it vectorizes across the axes.
+ * @param  bank: bank of ramps
+ * @param  target: array of n targets
+ * @param  output: array of n outputs
+ */
+void lw_ramp_bank_step(ramp_bank_t *bank, const int16_t *target,
+                       int16_t *output) {
+
+  const int32_t *rate = bank->rate;
+  const int32_t *accel = bank->accel;
+  int32_t *value = bank->value;
+  int32_t *speed = bank->speed;
+  uint32_t n = bank->n;
+  uint32_t i;
+  int32_t err;
+  int32_t u;
+  int32_t u_prev;
+  int32_t u_acc;
+  int32_t u_hold;
+  int32_t u_dec;
+  int32_t crv;
+  int32_t lin;
+  int32_t spd;
+  int32_t reach;
+  int32_t lin_reach;
+  int32_t acc_reach;
+  int64_t two_ae;
+  int64_t dist;
+
+  for (i = 0u; i < n; i++) {
+    /* both operands are within [-2^30, 2^30 - 2^15], the difference fits */
+    err = ((int32_t)target[i] * 32768) - value[i];
+
+    /* linear ramp: the slew-limited distance */
+    lin = LIMIT(err, -rate[i], rate[i]);
+
+    /* acceleration-limited ramp: u is the speed towards the target. The
+     * speed rises by accel, holds or falls by accel, whichever is the
+     * fastest that still stops in time: braking from u takes about
+     * (u^2 + accel * u) / 2accel of distance. The products are 32 x 32
+     * bits, no division. */
+    dist = (err < 0) ? -(int64_t)err : (int64_t)err;
+    u = (err < 0) ? -speed[i] : speed[i];
+    u_prev = u;
+    two_ae = 2 * (int64_t)accel[i] * dist;
+    u_acc = u + accel[i];
+    u_acc = (u_acc < rate[i]) ? u_acc : rate[i];
+    u_hold = (u < rate[i]) ? u : rate[i];
+    u_dec = u - accel[i];
+    u_dec = (u_dec > accel[i]) ? u_dec : accel[i];
+    u = ((((int64_t)u_hold * u_hold) + ((int64_t)accel[i] * u_hold)) <= two_ae) ?
+        u_hold : u_dec;
+    u = ((u_acc <= 0) ||
+         ((((int64_t)u_acc * u_acc) + ((int64_t)accel[i] * u_acc)) <= two_ae)) ? u_acc : u;
+    crv = (err < 0) ? -u : u;
+
+    spd = (0 == accel[i]) ? lin : crv;
+
+    /* the last step lands exactly on the target: a linear axis once err
+     * is within rate, an acceleration-limited one once moving by err and
+     * then stopping each change its speed by at most accel. When the
+     * target moved inside the braking distance, the axis passes it,
+     * brakes at accel and comes back. */
+    lin_reach = (err >= 0) ? (lin >= err) : (lin <= err);
+    acc_reach = (dist <= accel[i]) && (((int64_t)u_prev - dist) <= accel[i]) &&
+                ((dist - (int64_t)u_prev) <= accel[i]);
+    reach = (0 == accel[i]) ? lin_reach : acc_reach;
+    value[i] = reach ? (value[i] + err) : LIMIT(value[i] + spd, RAMP_VALUE_MIN, RAMP_VALUE_MAX);
+    speed[i] = reach ? 0 : spd;
+    output[i] = (int16_t)((value[i] + 16384) >> 15);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Filename              :   lw_resample.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_resample.c
+ *  @brief This module handles the polyphase sample-rate converter
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include "lw_resample.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define RESAMPLE_PI    3.14159265358979323846
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int16_t lw_resample_dot(const resample_t *rs);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function designs the prototype filter of a converter, a
+ *         Blackman windowed sinc cut at the lower of the two Nyquist
+ *         frequencies with a gain of up, and stores it phase by phase
+ * @param  coef: array of RESAMPLE_COEF_SIZE coefficients in q1.15 format
+ * @param  up: interpolation factor (> 0)
+ * @param  down: decimation factor (> 0)
+ * @param  n_taps: taps per phase (> 0)
+ */
+void lw_resample_design(int16_t *coef, uint16_t up, uint16_t down,
+                        uint16_t n_taps) {
+
+  uint32_t len = RESAMPLE_COEF_SIZE(up, n_taps);
+  uint32_t p;
+  uint32_t j;
+  uint32_t i;
+  double fc = 0.5 / (double)((up > down) ? up : down);
+  double center = ((double)len - 1.0) / 2.0;
+  double t;
+  double w;
+  double h;
+
+  for (p = 0u; p < up; p++) {
+    for (j = 0u; j < n_taps; j++) {
+      /* tap i of the prototype at the upsampled rate */
+      i = p + (up * j);
+      t = (double)i - center;
+      h = (0.0 == t) ? (2.0 * fc) : (sin(2.0 * RESAMPLE_PI * fc * t) / (RESAMPLE_PI * t));
+      w = (len > 1u) ? (0.42 - (0.5 * cos((2.0 * RESAMPLE_PI * i) / (len - 1u))) +
+                       (0.08 * cos((4.0 * RESAMPLE_PI * i) / (len - 1u)))) : 1.0;
+      h = floor((h * w * up * 32768.0) + 0.5);
+
+      coef[(p * n_taps) + j] = (int16_t)LIMIT(h, -INT16_MAX, INT16_MAX);
+    }
+  }
+}
+
+/**
+ * @brief  This function initializes a converter with a cleared delay line.
+ *         up and down should be reduced by their common divisor.
+ * @param  rs: converter to initialize
+ * @param  coef: array of RESAMPLE_COEF_SIZE coefficients stored phase by
+ *         phase, e.g. from lw_resample_design, owned by the caller
+ * @param  delay: array of RESAMPLE_DELAY_SIZE samples, owned by the caller
+ * @param  up: interpolation factor (> 0)
+ * @param  down: decimation factor (> 0)
+ * @param  n_taps: taps per phase (> 0)
+ */
+void lw_resample_init(resample_t *rs, const int16_t *coef, int16_t *delay,
+                      uint16_t up, uint16_t down, uint16_t n_taps) {
+
+  rs->coef = coef;
+  rs->delay = delay;
+  rs->up = (up > 0u) ? up : 1u;
+  rs->down = (down > 0u) ? down : 1u;
+  rs->n_taps = (n_taps > 0u) ? n_taps : 1u;
+
+  lw_resample_reset(rs);
+}
+
+/**
+ * @brief  This function clears the delay line of a converter
+ * @param  rs: converter
+ */
+void lw_resample_reset(resample_t *rs) {
+
+  uint32_t i;
+
+  for (i = 0u; i < RESAMPLE_DELAY_SIZE(rs->n_taps); i++) {
+    rs->delay[i] = 0;
+  }
+
+  rs->pos = 0u;
+  rs->phase = 0u;
+}
+
+/**
+ * @brief  This function converts a block of samples. The phase and the
+ *         delay line are kept across blocks of any length, so a stream cut
+ *         in blocks gives the same output as a single pass.
+ * @param  rs: converter
+ * @param  input: array of n input samples
+ * @param  output: array of RESAMPLE_OUT_SIZE(n, up, down) output samples
+ * @param  n: number of input samples
+ * @retval number of output samples written
+ */
+uint32_t lw_resample_process(resample_t *rs, const int16_t *input,
+                             int16_t *output, uint32_t n) {
+
+  uint32_t k;
+  uint32_t n_out = 0u;
+  uint32_t phase = rs->phase;
+  uint32_t up = rs->up;
+  uint32_t down = rs->down;
+  uint16_t n_taps = rs->n_taps;
+
+  for (k = 0u; k < n; k++) {
+    rs->pos = (0u == rs->pos) ? (uint16_t)(n_taps - 1u) : (uint16_t)(rs->pos - 1u);
+    rs->delay[rs->pos] = input[k];
+    rs->delay[rs->pos + n_taps] = input[k];
+
+    /* outputs falling between this input and the next one */
+    while (phase < up) {
+      rs->phase = (uint16_t)phase;
+      output[n_out] = lw_resample_dot(rs);
+      n_out++;
+      phase += down;
+    }
+    phase -= up;
+  }
+
+  rs->phase = (uint16_t)phase;
+
+  return (n_out);
+}
+
+/**
+ * @brief  Computes an output from the newest n_taps samples and the
+ *         coefficients of the current phase. The products are summed in an
+ *         int64 and the loop is a contiguous dot product that vectorizes.
+ * @param  rs: converter
+ * @retval output sample, rounded and saturated to [-32767, 32767]
+ */
+static int16_t lw_resample_dot(const resample_t *rs) {
+
+  const int16_t *coef = &rs->coef[(uint32_t)rs->phase * rs->n_taps];
+  const int16_t *x = &rs->delay[rs->pos];
+  uint32_t n_taps = rs->n_taps;
+  uint32_t i;
+  int64_t acc = 0;
+
+  for (i = 0u; i < n_taps; i++) {
+    acc += (int32_t)coef[i] * (int32_t)x[i];
+  }
+
+  acc = (acc + 16384) >> 15;
+
+  return ((int16_t)LIMIT(acc, -INT16_MAX, INT16_MAX));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * Filename              :   lw_rfft.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_rfft.c
+ *  @brief This module handles windowing, real FFT and power spectrum of
+ *         real q1.15 signals
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include "lw_rfft.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define ONE_Q31         ((int64_t)1 << 31)
+#define BLACKMAN_A0     901943132       /* 0.42 in q1.31 format */
+#define BLACKMAN_A2     171798692       /* 0.08 in q1.31 format */
+#define SPLIT_LIMIT_1   13573           /* 32767 / (1 + sqrt(2)) */
+#define SPLIT_LIMIT_2   27146           /* 2 * SPLIT_LIMIT_1 */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define ABS(x) (((x) < 0) ? -(x) : (x))
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function fills a window table in q1.15 format, with the
+ *         cosines of lw_fft_twiddle so no floating point is needed
+ * @param  window: array of n coefficients
+ * @param  n: window length
+ * @param  type: window type
+ */
+void lw_rfft_window_init(int16_t *window, uint32_t n, rfft_window_t type) {
+
+  uint32_t i;
+  uint32_t phase;
+  int64_t c1;
+  int64_t c2;
+  int64_t w;
+
+  for (i = 0u; i < n; i++) {
+    /* 2^32 * i / n, the phase of the DFT-even window */
+    phase = (uint32_t)((((uint64_t)i << 32) + (n / 2u)) / n);
+    c1 = lw_fft_twiddle(phase).cos;
+
+    if (RFFT_WINDOW_BLACKMAN == type) {
+      c2 = lw_fft_twiddle(phase * 2u).cos;
+      w = BLACKMAN_A0 - (c1 / 2) + ((c2 * BLACKMAN_A2) >> 31);
+    }
+    else {
+      w = (ONE_Q31 - c1) / 2;
+    }
+
+    window[i] = (int16_t)LIMIT((w + 32768) >> 16, 0, INT16_MAX);
+  }
+}
+
+/**
+ * @brief  This function multiplies a block of samples by a window
+ * @param  window: array of n coefficients in q1.15 format
+ * @param  input: array of n samples
+ * @param  output: array of n windowed samples, may be input
+ * @param  n: number of samples
+ */
+void lw_rfft_window_apply(const int16_t *window, const int16_t *input,
+                          int16_t *output, uint32_t n) {
+
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    output[i] = (int16_t)((((int32_t)input[i] * window[i]) + 16384) >> 15);
+  }
+}
+
+/**
+ * @brief  This function computes the spectrum of a real signal with a
+ *         complex FFT of half the size: the even and odd samples are packed
+ *         as real and imaginary parts, transformed by lw_fft_q15 and
+ *         separated by the split step, which may add up to 2 bits to the
+ *         block exponent.
+ * @param  input: array of 2^log2n real samples
+ * @param  output: array of 2^(log2n - 1) + 1 bins, from DC to fs/2
+ * @param  log2n: base 2 logarithm of the size, 2 to LW_FFT_MAX_LOG2N + 1
+ * @param  exponent: block exponent, the spectrum is output * 2^exponent
+ * @retval 0 on success, EINVAL for an unsupported size
+ */
+int lw_rfft_q15(const int16_t *input, complex_q15_t *output, uint8_t log2n,
+                int16_t *exponent) {
+
+  uint32_t m;
+  uint32_t k;
+  uint8_t shift;
+  int16_t fft_exp;
+  int32_t max = 0;
+  int32_t z0_re;
+  int32_t z0_im;
+  int32_t e_re;
+  int32_t e_im;
+  int32_t o_re;
+  int32_t o_im;
+  int32_t wo_re;
+  int32_t wo_im;
+  int32_t w_re;
+  int32_t w_im;
+  fft_twiddle_t tw;
+  complex_q15_t zk;
+  complex_q15_t zmk;
+
+  if ((log2n < 2u) || (log2n > (LW_FFT_MAX_LOG2N + 1u))) {
+    return (EINVAL);
+  }
+
+  m = (uint32_t)1 << (log2n - 1u);
+  for (k = 0u; k < m; k++) {
+    output[k].re = input[2u * k];
+    output[k].im = input[(2u * k) + 1u];
+  }
+
+  (void)lw_fft_q15(output, (uint8_t)(log2n - 1u), FFT_FORWARD, FFT_ORDER_NATURAL,
+                   &fft_exp);
+
+  for (k = 0u; k < m; k++) {
+    max = (ABS((int32_t)output[k].re) > max) ? ABS((int32_t)output[k].re) : max;
+    max = (ABS((int32_t)output[k].im) > max) ? ABS((int32_t)output[k].im) : max;
+  }
+
+  /* |E| and |O| are bounded by the largest input, a component of
+   * E + W*O by (1 + sqrt(2)) times it */
+  shift = (uint8_t)((max <= SPLIT_LIMIT_1) ? 1u : ((max <= SPLIT_LIMIT_2) ? 2u : 3u));
+
+  /* DC and fs/2 from Z[0]: X[0] = re + im, X[M] = re - im */
+  z0_re = ((int32_t)output[0].re * 2) >> shift;
+  z0_im = ((int32_t)output[0].im * 2) >> shift;
+  output[0].re = (int16_t)(z0_re + z0_im);
+  output[0].im = 0;
+  output[m].re = (int16_t)(z0_re - z0_im);
+  output[m].im = 0;
+
+  /* X[k] = E + W^k*O and X[M-k] = conj(E - W^k*O) with
+   * E = (Z[k] + conj(Z[M-k]))/2, O = (Z[k] - conj(Z[M-k]))/(2j) */
+  for (k = 1u; k <= (m / 2u); k++) {
+    zk = output[k];
+    zmk = output[m - k];
+
+    e_re = ((int32_t)zk.re + zmk.re) >> shift;
+    e_im = ((int32_t)zk.im - zmk.im) >> shift;
+    o_re = ((int32_t)zk.im + zmk.im) >> shift;
+    o_im = ((int32_t)zmk.re - zk.re) >> shift;
+
+    tw = lw_fft_twiddle(k << (32u - log2n));
+    w_re = ((int32_t)tw.cos + 32768) >> 16;
+    w_im = -(((int32_t)tw.sin + 32768) >> 16);
+    wo_re = ((o_re * w_re) - (o_im * w_im) + 16384) >> 15;
+    wo_im = ((o_re * w_im) + (o_im * w_re) + 16384) >> 15;
+
+    output[k].re = (int16_t)(e_re + wo_re);
+    output[k].im = (int16_t)(e_im + wo_im);
+    output[m - k].re = (int16_t)(e_re - wo_re);
+    output[m - k].im = (int16_t)(wo_im - e_im);
+  }
+
+  *exponent = (int16_t)(fft_exp + (int16_t)shift - 1);
+
+  return (0);
+}
+
+/**
+ * @brief  This function computes the power spectrum re^2 + im^2 of a block
+ *         of bins. With the block exponent e of the spectrum, the power is
+ *         power * 2^(2e) in q2.30 units.
+ * @param  spectrum: array of n bins
+ * @param  power: array of n powers
+ * @param  n: number of bins
+ */
+void lw_rfft_power_q15(const complex_q15_t *spectrum, uint32_t *power,
+                       uint32_t n) {
+
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    power[i] = (uint32_t)((int32_t)spectrum[i].re * spectrum[i].re) +
+               (uint32_t)((int32_t)spectrum[i].im * spectrum[i].im);
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
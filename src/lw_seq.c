@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Filename              :   lw_seq.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_seq.c
+ *  @brief This module handles the positive and negative sequence extraction
+ *         in fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_lpf.h"
+#include "lw_seq.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/* negated and doubled q1.15 angles, wrapping on 16 bit */
+#define NEG_ANGLE(a)    ((int16_t)(uint16_t)(0u - (uint16_t)(a)))
+#define DOUBLE_ANGLE(a) ((int16_t)(uint16_t)((uint16_t)(a) << 1))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int16_t lw_seq_sub_sat(int16_t a, int16_t b);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a sequence extractor
+ * @param  seq: sequence extractor to initialize
+ * @param  lpf_coef: low-pass coefficient of the decoupling network in q1.15
+ *         format, wf*Ts/(1+wf*Ts) with wf usually set to w/sqrt(2)
+ */
+void lw_seq_init(seq_t *seq, int16_t lpf_coef) {
+  seq->lpf_coef = lpf_coef;
+  lw_seq_reset(seq);
+}
+
+/**
+ * @brief  This function resets the state of a sequence extractor
+ * @param  seq: sequence extractor to reset
+ */
+void lw_seq_reset(seq_t *seq) {
+  seq->pos_q = 0;
+  seq->pos_d = 0;
+  seq->neg_q = 0;
+  seq->neg_d = 0;
+}
+
+/**
+ * @brief  This function runs one step of the sequence extractor. The
+ *         positive sequence is taken on the frame rotating at theta, the
+ *         negative one on the frame rotating at -theta, and each of them is
+ *         decoupled from the 2*theta ripple induced by the other one.
+ * @param  seq: sequence extractor
+ * @param  input: components alpha and beta in alphabeta_t format
+ * @param  theta: angular position of the fundamental in q1.15 format
+ * @retval Positive and negative sequence components in seq_out_t format
+ */
+seq_out_t lw_seq_step(seq_t *seq, alphabeta_t input, int16_t theta) {
+
+  seq_out_t output;
+  qd_t pos_raw;
+  qd_t neg_raw;
+  qd_t cross;
+  alphabeta_t filtered;
+
+  pos_raw = lw_math_park(input, theta);
+  neg_raw = lw_math_park(input, NEG_ANGLE(theta));
+
+  /* the negative sequence shows up on the positive frame rotated by 2*theta */
+  filtered.alpha = (int16_t)(seq->neg_q >> 16);
+  filtered.beta = (int16_t)(seq->neg_d >> 16);
+  cross = lw_math_park(filtered, DOUBLE_ANGLE(theta));
+  pos_raw.q = lw_seq_sub_sat(pos_raw.q, cross.q);
+  pos_raw.d = lw_seq_sub_sat(pos_raw.d, cross.d);
+
+  /* and the positive sequence on the negative frame rotated by -2*theta */
+  filtered.alpha = (int16_t)(seq->pos_q >> 16);
+  filtered.beta = (int16_t)(seq->pos_d >> 16);
+  cross = lw_math_park(filtered, NEG_ANGLE(DOUBLE_ANGLE(theta)));
+  neg_raw.q = lw_seq_sub_sat(neg_raw.q, cross.q);
+  neg_raw.d = lw_seq_sub_sat(neg_raw.d, cross.d);
+
+  output.pos.q = lw_lpf_step(&seq->pos_q, pos_raw.q, seq->lpf_coef);
+  output.pos.d = lw_lpf_step(&seq->pos_d, pos_raw.d, seq->lpf_coef);
+  output.neg.q = lw_lpf_step(&seq->neg_q, neg_raw.q, seq->lpf_coef);
+  output.neg.d = lw_lpf_step(&seq->neg_d, neg_raw.d, seq->lpf_coef);
+
+  return (output);
+}
+
+/**
+ * @brief  This function runs one step of several sequence extractors, one
+ *         for each channel
+ * @param  seq: array of n_channels sequence extractors
+ * @param  input: array of n_channels alpha and beta components
+ * @param  theta: array of n_channels angular positions in q1.15 format
+ * @param  output: array of n_channels positive and negative sequence components
+ * @param  n_channels: number of channels
+ */
+void lw_seq_step_block(seq_t *seq, const alphabeta_t *input, const int16_t *theta,
+                       seq_out_t *output, uint16_t n_channels) {
+
+  uint16_t i;
+
+  for (i = 0u; i < n_channels; i++) {
+    output[i] = lw_seq_step(&seq[i], input[i], theta[i]);
+  }
+}
+
+/**
+ * @brief  Saturated difference of two q1.15 numbers
+ * @param  a: minuend
+ * @param  b: subtrahend
+ * @retval a - b saturated to [-32767, 32767]
+ */
+static int16_t lw_seq_sub_sat(int16_t a, int16_t b) {
+
+  int32_t diff = (int32_t)a - (int32_t)b;
+
+  return (diff > INT16_MAX) ? INT16_MAX :
+         ((diff < -INT16_MAX) ? (int16_t)-INT16_MAX : (int16_t)diff);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,170 @@
+/******************************************************************************
+ * Filename              :   lw_smo.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_smo.c
+ *  @brief This module handles the sliding-mode back-EMF observer in
+ *         fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_lpf.h"
+#include "lw_smo.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define ANGLE_90  (uint16_t)16384    /* pi/2 in q1.15 format */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static int16_t lw_smo_axis(smo_t *smo, int16_t *i_est, int16_t i_meas,
+                           int16_t v, int32_t *emf);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a sliding-mode observer. The angle
+ *         tracking loop is initialized with lw_pll_init(&smo->pll, ...)
+ *         afterwards.
+ * @param  smo: observer to initialize
+ * @param  f: model pole 1 - R*Ts/L in q1.15 format
+ * @param  g: model input gain Ts/L in q1.15 format
+ * @param  k_smo: switching term amplitude, above the largest back-EMF
+ * @param  band: current error where the switching term saturates (> 0)
+ * @param  lpf_coef: back-EMF low-pass coefficient in q1.15 format
+ */
+void lw_smo_init(smo_t *smo, int16_t f, int16_t g, int16_t k_smo, int16_t band,
+                 int16_t lpf_coef) {
+
+  smo->f = f;
+  smo->g = g;
+  smo->k_smo = k_smo;
+  smo->slope = ((int32_t)k_smo * 32768) / ((band > 0) ? (int32_t)band : 1);
+  smo->lpf_coef = lpf_coef;
+  smo->i_est.alpha = 0;
+  smo->i_est.beta = 0;
+  smo->emf_alpha = 0;
+  smo->emf_beta = 0;
+  smo->theta = 0;
+}
+
+/**
+ * @brief  This function runs one step of the observer
+ * @param  smo: observer
+ * @param  current: measured current in alphabeta_t format
+ * @param  voltage: applied voltage in alphabeta_t format
+ * @retval estimated rotor angle in q1.15 format. The back-EMF leads the
+ *         rotor flux by 90 degrees in the direction of rotation; the lag of
+ *         the back-EMF filter is not compensated.
+ */
+int16_t lw_smo_step(smo_t *smo, alphabeta_t current, alphabeta_t voltage) {
+
+  alphabeta_t emf;
+  uint16_t emf_angle;
+
+  emf.alpha = lw_smo_axis(smo, &smo->i_est.alpha, current.alpha, voltage.alpha,
+                          &smo->emf_alpha);
+  emf.beta = lw_smo_axis(smo, &smo->i_est.beta, current.beta, voltage.beta,
+                         &smo->emf_beta);
+
+  emf_angle = (uint16_t)lw_pll_step(&smo->pll, emf);
+
+  if (smo->pll.speed >= 0) {
+    smo->theta = (int16_t)(uint16_t)(emf_angle - ANGLE_90);
+  }
+  else {
+    smo->theta = (int16_t)(uint16_t)(emf_angle + ANGLE_90);
+  }
+
+  return (smo->theta);
+}
+
+/**
+ * @brief  This function returns the filtered back-EMF of an observer
+ * @param  smo: observer
+ * @retval back-EMF in alphabeta_t format
+ */
+alphabeta_t lw_smo_get_emf(const smo_t *smo) {
+
+  alphabeta_t emf;
+
+  emf.alpha = (int16_t)(smo->emf_alpha >> 16);
+  emf.beta = (int16_t)(smo->emf_beta >> 16);
+
+  return (emf);
+}
+
+/**
+ * @brief  This function runs one step of several observers, one for each
+ *         motor
+ * @param  smo: array of n observers
+ * @param  current: array of n measured currents
+ * @param  voltage: array of n applied voltages
+ * @param  n: number of observers
+ */
+void lw_smo_step_batch(smo_t *smo, const alphabeta_t *current,
+                       const alphabeta_t *voltage, uint16_t n) {
+
+  uint16_t i;
+
+  for (i = 0u; i < n; i++) {
+    (void)lw_smo_step(&smo[i], current[i], voltage[i]);
+  }
+}
+
+/**
+ * @brief  Runs the observer on one axis
+ * @param  smo: observer
+ * @param  i_est: estimated current of the axis, updated
+ * @param  i_meas: measured current of the axis
+ * @param  v: applied voltage of the axis
+ * @param  emf: filtered back-EMF of the axis, upper 16 bits, updated
+ * @retval filtered back-EMF of the axis
+ */
+static int16_t lw_smo_axis(smo_t *smo, int16_t *i_est, int16_t i_meas,
+                           int16_t v, int32_t *emf) {
+
+  int32_t z;
+  int32_t next;
+  int64_t error;
+
+  /* switching term: linear inside the band, k_smo outside */
+  error = (int64_t)*i_est - (int64_t)i_meas;
+  z = (int32_t)LIMIT((error * smo->slope) / 32768, -(int64_t)smo->k_smo,
+                     (int64_t)smo->k_smo);
+
+  next = (((int32_t)smo->f * (int32_t)*i_est) +
+          ((int32_t)smo->g * LIMIT((int32_t)v - z, -INT16_MAX, INT16_MAX))) / 32768;
+  *i_est = (int16_t)LIMIT(next, -INT16_MAX, INT16_MAX);
+
+  return (lw_lpf_step(emf, (int16_t)z, smo->lpf_coef));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * Filename              :   lw_stream.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_stream.c
+ *  @brief This module handles the streaming transformation pipeline in
+ *         fixed-point format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include "lw_lpf.h"
+#include "lw_stream.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void lw_stream_span(stream_t *stream, const ab_t *in, const int16_t *theta,
+                           qd_t *out, uint32_t n);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a streaming pipeline
+ * @param  stream: pipeline to initialize
+ * @param  theta: angle of the first sample in q1.15 format, used when the
+ *         input ring carries no angles
+ * @param  dtheta: angle increment per sample in q1.15 format
+ * @param  lpf_coef: first order low-pass coefficient applied to q and d in
+ *         q1.15 format, 0 to disable the filter
+ */
+void lw_stream_init(stream_t *stream, int16_t theta, int16_t dtheta,
+                    int16_t lpf_coef) {
+  stream->theta = theta;
+  stream->dtheta = dtheta;
+  stream->lpf_coef = lpf_coef;
+  stream->q_state = 0;
+  stream->d_state = 0;
+}
+
+/**
+ * @brief  This function consumes samples from the input ring, applies the
+ *         Clarke and Park transformations (and the optional low-pass
+ *         filter) in a single pass and writes the result straight into the
+ *         output ring. Wrap-around of both rings is handled by splitting
+ *         the work into contiguous spans. The pipeline is the consumer of
+ *         the input ring and the producer of the output ring.
+ * @param  stream: pipeline
+ * @param  input: ring of a, b samples
+ * @param  output: ring of q, d samples
+ * @param  max_samples: maximum number of samples to process
+ * @retval number of samples processed, limited by the samples available in
+ *         the input ring and by the free space in the output ring
+ */
+uint32_t lw_stream_process(stream_t *stream, ab_ring_t *input,
+                           qd_ring_t *output, uint32_t max_samples) {
+
+  uint32_t in_tail = input->tail;
+  uint32_t out_head = output->head;
+  uint32_t todo;
+  uint32_t space;
+  uint32_t done = 0u;
+  uint32_t rd;
+  uint32_t wr;
+  uint32_t span;
+
+  /* head and tail of the other side are sampled once; the acquire loads
+   * order the sample reads and writes below after them */
+  todo = LW_RING_LOAD_ACQUIRE(&input->head) - in_tail;
+  space = (output->mask + 1u) - (out_head - LW_RING_LOAD_ACQUIRE(&output->tail));
+  if (todo > space) {
+    todo = space;
+  }
+  if (todo > max_samples) {
+    todo = max_samples;
+  }
+
+  while (done < todo) {
+
+    rd = in_tail & input->mask;
+    wr = out_head & output->mask;
+
+    /* largest span contiguous in both rings */
+    span = todo - done;
+    if (span > ((input->mask + 1u) - rd)) {
+      span = (input->mask + 1u) - rd;
+    }
+    if (span > ((output->mask + 1u) - wr)) {
+      span = (output->mask + 1u) - wr;
+    }
+
+    lw_stream_span(stream, &input->buf[rd],
+                   (input->theta != NULL) ? &input->theta[rd] : NULL,
+                   &output->buf[wr], span);
+
+    in_tail += span;
+    out_head += span;
+    done += span;
+
+    /* publish each span as soon as it is ready, after its samples */
+    LW_RING_STORE_RELEASE(&input->tail, in_tail);
+    LW_RING_STORE_RELEASE(&output->head, out_head);
+  }
+
+  return (done);
+}
+
+/**
+ * @brief  Runs the pipeline on a contiguous span of samples
+ * @param  stream: pipeline
+ * @param  in: input samples
+ * @param  theta: angle of each input sample, or NULL to use the pipeline angle
+ * @param  out: output samples
+ * @param  n: number of samples
+ */
+static void lw_stream_span(stream_t *stream, const ab_t *in, const int16_t *theta,
+                           qd_t *out, uint32_t n) {
+
+  uint32_t i;
+  int16_t angle;
+  qd_t qd;
+
+  for (i = 0u; i < n; i++) {
+
+    if (theta != NULL) {
+      angle = theta[i];
+    }
+    else {
+      angle = stream->theta;
+      stream->theta = (int16_t)(uint16_t)((uint16_t)stream->theta +
+                                          (uint16_t)stream->dtheta);
+    }
+
+    qd = lw_math_park(lw_math_clarke(in[i]), angle);
+
+    if (stream->lpf_coef != 0) {
+      qd.q = lw_lpf_step(&stream->q_state, qd.q, stream->lpf_coef);
+      qd.d = lw_lpf_step(&stream->d_state, qd.d, stream->lpf_coef);
+    }
+
+    out[i] = qd;
+  }
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Filename              :   lw_svpwm.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_svpwm.c
+ *  @brief This module handles the space vector modulation in fixed-point
+ *         format
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_svpwm.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define SQRT3_2 (int32_t)0x6ED9      /* sqrt(3)/2 in q1.15 format=0.8660254*/
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static uint16_t lw_svpwm_compare(const svpwm_t *svpwm, int32_t voltage);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/* sector from the phase ordering, index is (a>=b) | (b>=c)<<1 | (c>=a)<<2 */
+static const uint8_t sector_table[8] = {1u, 6u, 2u, 1u, 4u, 5u, 3u, 1u};
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes a space vector modulator. The DC bus
+ *         voltage has to be set with lw_svpwm_set_vbus before running it.
+ * @param  svpwm: modulator to initialize
+ * @param  period: timer period in counts
+ * @param  mode: modulation sequence
+ */
+void lw_svpwm_init(svpwm_t *svpwm, uint16_t period, svpwm_mode_t mode) {
+  svpwm->period = period;
+  svpwm->mode = mode;
+  svpwm->vbus = 0;
+  svpwm->gain = 0;
+}
+
+/**
+ * @brief  This function updates the DC bus voltage of a modulator. It is
+ *         the only place where a division is performed, so it should be
+ *         called at the bus voltage sampling rate, not at the PWM rate.
+ * @param  svpwm: modulator
+ * @param  vbus: DC bus voltage, same unit as the alpha-beta input
+ */
+void lw_svpwm_set_vbus(svpwm_t *svpwm, int16_t vbus) {
+
+  svpwm->vbus = vbus;
+
+  if (vbus > 0) {
+    /* at most 65535 * 32768 = 2147450880 with vbus = 1, below INT32_MAX */
+    svpwm->gain = (int32_t)(((uint32_t)svpwm->period << 15) / (uint32_t)vbus);
+  }
+  else {
+    /* no bus, all phases stay at 50% */
+    svpwm->gain = 0;
+  }
+}
+
+/**
+ * @brief  This function computes the timer compare values of the voltage
+ *         vector fed in input. Vectors beyond the linear range are clipped
+ *         on the phase that exceeds the bus.
+ * @param  svpwm: modulator
+ * @param  input: voltage components alpha and beta in alphabeta_t format
+ * @retval Compare values and sector in svpwm_out_t format
+ */
+svpwm_out_t lw_svpwm_run(const svpwm_t *svpwm, alphabeta_t input) {
+
+  svpwm_out_t output;
+  int32_t va;
+  int32_t vb;
+  int32_t vc;
+  int32_t beta_tmp;
+  int32_t vmax;
+  int32_t vmin;
+  int32_t offset;
+  uint8_t index;
+
+  /* phase voltages, inverse of lw_math_clarke:
+                   va = alpha
+                   vb = -alpha/2 - sqrt(3)/2 * beta
+                   vc = -alpha/2 + sqrt(3)/2 * beta */
+  beta_tmp = (SQRT3_2 * (int32_t)input.beta) / 32768;
+  va = (int32_t)input.alpha;
+  vb = -(va / 2) - beta_tmp;
+  vc = -(va / 2) + beta_tmp;
+
+  index = (uint8_t)((uint8_t)(va >= vb) | ((uint8_t)(vb >= vc) << 1) |
+                    ((uint8_t)(vc >= va) << 2));
+  output.sector = sector_table[index];
+
+  vmax = (va > vb) ? va : vb;
+  vmax = (vc > vmax) ? vc : vmax;
+  vmin = (va < vb) ? va : vb;
+  vmin = (vc < vmin) ? vc : vmin;
+
+  if (SVPWM_5_SEGMENT == svpwm->mode) {
+    /* clamp the phase with the largest magnitude to its own rail */
+    if ((vmax + vmin) >= 0) {
+      offset = ((int32_t)svpwm->vbus / 2) - vmax;
+    }
+    else {
+      offset = -((int32_t)svpwm->vbus / 2) - vmin;
+    }
+  }
+  else {
+    /* center the active vectors, equal to the symmetric sector timing */
+    offset = -((vmax + vmin) / 2);
+  }
+
+  output.cmp_a = lw_svpwm_compare(svpwm, va + offset);
+  output.cmp_b = lw_svpwm_compare(svpwm, vb + offset);
+  output.cmp_c = lw_svpwm_compare(svpwm, vc + offset);
+
+  return (output);
+}
+
+/**
+ * @brief  This function computes the timer compare values of several
+ *         inverters
+ * @param  svpwm: array of n_inverters modulators
+ * @param  input: array of n_inverters voltage vectors
+ * @param  output: array of n_inverters compare values
+ * @param  n_inverters: number of inverters
+ */
+void lw_svpwm_run_batch(const svpwm_t *svpwm, const alphabeta_t *input,
+                        svpwm_out_t *output, uint16_t n_inverters) {
+
+  uint16_t i;
+
+  for (i = 0u; i < n_inverters; i++) {
+    output[i] = lw_svpwm_run(&svpwm[i], input[i]);
+  }
+}
+
+/**
+ * @brief  Converts a pole voltage, referred to the bus midpoint, into a
+ *         compare value clipped to the timer period
+ * @param  svpwm: modulator
+ * @param  voltage: pole voltage
+ * @retval compare value in counts
+ */
+static uint16_t lw_svpwm_compare(const svpwm_t *svpwm, int32_t voltage) {
+
+  int32_t cmp;
+
+  cmp = ((int32_t)svpwm->period / 2) +
+        (int32_t)(((int64_t)voltage * svpwm->gain) / 32768);
+
+  if (cmp < 0) {
+    cmp = 0;
+  }
+  else if (cmp > (int32_t)svpwm->period) {
+    cmp = (int32_t)svpwm->period;
+  }
+  else {
+    /* within the period */
+  }
+
+  return ((uint16_t)cmp);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
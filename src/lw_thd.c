@@ -0,0 +1,236 @@
+/******************************************************************************
+ * Filename              :   lw_thd.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_thd.c
+ *  @brief This module handles the harmonic distortion analyzer
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include "lw_thd.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define ANGLE_90    16384u    /* pi/2 in q1.15 format */
+#define ANGLE_270   49152u    /* 3*pi/2 in q1.15 format */
+
+/*****************************************************************************
+ * Module Preprocessor Macros
+ ******************************************************************************/
+
+#define LIMIT(x, lo, hi) (((x) < (lo)) ? (lo) : (((x) > (hi)) ? (hi) : (x)))
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void lw_thd_clear(thd_t *thd);
+static void lw_thd_close(thd_t *thd);
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  This function initializes an analyzer. The first window starts at
+ *         the first wrap of the fundamental angle.
+ * @param  thd: analyzer to initialize
+ * @param  orders: array of n_orders positive orders, the first one 1
+ * @param  n_orders: number of orders, up to THD_MAX_ORDERS
+ * @param  n_cycles: fundamental periods per window (> 0)
+ * @param  ch: array of n_channels channels, owned by the caller
+ * @param  n_channels: number of channels
+ * @retval 0 on success, EINVAL for invalid orders
+ */
+int lw_thd_init(thd_t *thd, const int8_t *orders, uint8_t n_orders,
+                uint8_t n_cycles, thd_channel_t *ch, uint8_t n_channels) {
+
+  uint8_t c;
+  uint8_t k;
+
+  if ((0u == n_orders) || (n_orders > THD_MAX_ORDERS) || (1 != orders[0])) {
+    return (EINVAL);
+  }
+  for (k = 1u; k < n_orders; k++) {
+    if (orders[k] <= 0) {
+      return (EINVAL);
+    }
+  }
+
+  thd->orders = orders;
+  thd->ch = ch;
+  thd->n_orders = n_orders;
+  thd->n_channels = n_channels;
+  thd->n_cycles = (n_cycles > 0u) ? n_cycles : 1u;
+  thd->prev_theta = 0u;
+  thd->primed = 0u;
+  thd->synced = 0u;
+
+  for (c = 0u; c < n_channels; c++) {
+    for (k = 0u; k < THD_MAX_ORDERS; k++) {
+      ch[c].amplitude[k] = 0;
+    }
+    ch[c].thd = 0;
+  }
+
+  lw_thd_clear(thd);
+
+  return (0);
+}
+
+/**
+ * @brief  This function feeds a block of samples to the analyzer. At the
+ *         end of every window the amplitudes (lw_math_sqrt of the averaged
+ *         projections) and the THD of each channel are updated.
+ * @param  thd: analyzer
+ * @param  input: n samples of every channel, interleaved
+ * @param  theta: n fundamental angles in q1.15 format, e.g. from lw_pll
+ * @param  n: number of samples
+ * @retval number of windows completed in the block
+ */
+uint32_t lw_thd_process(thd_t *thd, const int16_t *input, const int16_t *theta,
+                        uint32_t n) {
+
+  qd_t proj[THD_MAX_ORDERS];
+  alphabeta_t sample;
+  thd_channel_t *ch;
+  uint32_t i;
+  uint32_t n_windows = 0u;
+  uint16_t angle;
+  uint8_t wrap;
+  uint8_t c;
+  uint8_t k;
+
+  sample.beta = 0;
+
+  for (i = 0u; i < n; i++) {
+    angle = (uint16_t)theta[i];
+
+    /* the angle crosses zero in either direction of rotation; the very
+     * first sample has no predecessor and cannot be a wrap */
+    wrap = (uint8_t)((0u != thd->primed) &&
+                     (((thd->prev_theta >= ANGLE_270) && (angle < ANGLE_90)) ||
+                      ((thd->prev_theta < ANGLE_90) && (angle >= ANGLE_270))));
+    thd->prev_theta = angle;
+    thd->primed = 1u;
+
+    if (0u != wrap) {
+      if (0u == thd->synced) {
+        thd->synced = 1u;
+      }
+      else {
+        thd->cycles++;
+        if (thd->cycles >= thd->n_cycles) {
+          lw_thd_close(thd);
+          n_windows++;
+        }
+      }
+    }
+
+    if (0u != thd->synced) {
+      for (c = 0u; c < thd->n_channels; c++) {
+        ch = &thd->ch[c];
+
+        /* a real signal is the alpha axis of a null beta vector: the
+         * harmonic frames give x*cos(k*theta) and x*sin(k*theta) */
+        sample.alpha = input[(i * thd->n_channels) + c];
+        lw_math_park_multi(sample, theta[i], thd->orders, proj, thd->n_orders);
+
+        for (k = 0u; k < thd->n_orders; k++) {
+          ch->acc_q[k] += proj[k].q;
+          ch->acc_d[k] += proj[k].d;
+        }
+      }
+      thd->n_samples++;
+    }
+  }
+
+  return (n_windows);
+}
+
+/**
+ * @brief  Clears the sums of the window in progress
+ * @param  thd: analyzer
+ */
+static void lw_thd_clear(thd_t *thd) {
+
+  uint8_t c;
+  uint8_t k;
+
+  for (c = 0u; c < thd->n_channels; c++) {
+    for (k = 0u; k < THD_MAX_ORDERS; k++) {
+      thd->ch[c].acc_q[k] = 0;
+      thd->ch[c].acc_d[k] = 0;
+    }
+  }
+
+  thd->n_samples = 0u;
+  thd->cycles = 0u;
+}
+
+/**
+ * @brief  Computes the results of the window in progress and starts a new
+ *         one
+ * @param  thd: analyzer
+ */
+static void lw_thd_close(thd_t *thd) {
+
+  thd_channel_t *ch;
+  int64_t n = (thd->n_samples > 0u) ? (int64_t)thd->n_samples : 1;
+  int64_t q;
+  int64_t d;
+  int64_t sum_sq;
+  int64_t fund_sq;
+  int64_t ratio;
+  uint8_t c;
+  uint8_t k;
+
+  for (c = 0u; c < thd->n_channels; c++) {
+    ch = &thd->ch[c];
+    sum_sq = 0;
+
+    for (k = 0u; k < thd->n_orders; k++) {
+      /* amplitude = 2 * |mean projection| */
+      q = LIMIT((2 * ch->acc_q[k]) / n, -INT16_MAX, INT16_MAX);
+      d = LIMIT((2 * ch->acc_d[k]) / n, -INT16_MAX, INT16_MAX);
+      /* the root reaches 46340 for two full scale components */
+      ch->amplitude[k] = (int16_t)LIMIT(lw_math_sqrt((int32_t)((q * q) + (d * d))),
+                                        0, INT16_MAX);
+
+      if (k > 0u) {
+        sum_sq += (int64_t)ch->amplitude[k] * ch->amplitude[k];
+      }
+    }
+
+    /* THD^2 in q2.30 format, saturated to the lw_math_sqrt input range: a
+     * sum above twice the fundamental saturates anyway, so it is clamped
+     * there before the shift to keep the product within the int64 */
+    fund_sq = (int64_t)ch->amplitude[0] * ch->amplitude[0];
+    sum_sq = LIMIT(sum_sq, 0, 2 * fund_sq);
+    ratio = (fund_sq > 0) ? ((sum_sq * ((int64_t)1 << 30)) / fund_sq) : 0;
+    ch->thd = (int16_t)LIMIT(lw_math_sqrt((int32_t)LIMIT(ratio, 0, INT32_MAX)),
+                             0, INT16_MAX);
+  }
+
+  lw_thd_clear(thd);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,50 @@
+/*****************************************************************************
+ * Filename              :   lw_bench.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_bench.h
+ *  @brief This module defines the timing helpers shared by the benchmark
+ *         drivers. The including file defines _POSIX_C_SOURCE 199309L
+ *         before any system header.
+ */
+
+#ifndef LW_BENCH_H_
+#define LW_BENCH_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <time.h>
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+/* shortest measurement of one configuration, in seconds */
+#define LW_BENCH_MIN_TIME   (0.2)
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  Returns a monotonic time stamp
+ * @retval time in seconds
+ */
+static double lw_bench_now(void) {
+
+  struct timespec ts;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ((double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9));
+}
+
+#endif /*LW_BENCH_H_*/
+
+/*** End of File *************************************************************/
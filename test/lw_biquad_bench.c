@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Filename              :   lw_biquad_bench.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_biquad_bench.c
+ *  @brief Benchmark driver of the biquad cascades: a 500 Hz notch followed
+ *         by a 2 kHz low-pass at 20 kHz, on 1 and 8 interleaved channels,
+ *         reported in samples per second over all the channels
+ *
+ *  usage: lw_biquad_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include "lw_biquad.h"
+#include "lw_bench.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define N_SECTIONS    (2u)
+#define MAX_CHANNELS  (8u)
+#define BLOCK         (1024u)     /* samples per channel and call */
+#define FS            (20000.0)
+#define TWO_PI        (6.283185307179586)
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const uint16_t channels_list[] = {1u, MAX_CHANNELS};
+
+static int16_t in_q15[BLOCK * MAX_CHANNELS];
+static int16_t out_q15[BLOCK * MAX_CHANNELS];
+static int32_t in_q31[BLOCK * MAX_CHANNELS];
+static int32_t out_q31[BLOCK * MAX_CHANNELS];
+static int16_t state_q15[BIQUAD_STATE_SIZE(N_SECTIONS, MAX_CHANNELS)];
+static int32_t state_q31[BIQUAD_STATE_SIZE(N_SECTIONS, MAX_CHANNELS)];
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  biquad_design_t design[N_SECTIONS];
+  biquad_q15_coef_t coef_q15[N_SECTIONS];
+  biquad_q31_coef_t coef_q31[N_SECTIONS];
+  biquad_q15_t bq15;
+  biquad_q31_t bq31;
+  uint32_t i;
+  uint32_t k;
+  uint32_t calls;
+  uint16_t n_ch;
+  double x;
+  double t0;
+  double t;
+  int64_t sink = 0;
+
+  lw_biquad_design(&design[0], BIQUAD_NOTCH, 500.0, FS, 2.0, 0.0);
+  lw_biquad_design(&design[1], BIQUAD_LOWPASS, 2000.0, FS, 0.7071, 0.0);
+  for (i = 0u; i < N_SECTIONS; i++) {
+    lw_biquad_q15_coef(&coef_q15[i], &design[i], BIQUAD_Q15_COEF_Q);
+    lw_biquad_q31_coef(&coef_q31[i], &design[i], BIQUAD_Q31_COEF_Q);
+  }
+
+  printf("%-8s %8s %14s\n", "format", "channels", "Msample/s");
+
+  for (k = 0u; k < (sizeof(channels_list) / sizeof(channels_list[0])); k++) {
+    n_ch = channels_list[k];
+
+    for (i = 0u; i < (BLOCK * n_ch); i++) {
+      x = 0.5 * sin(TWO_PI * 50.0 * (double)(i / n_ch) / FS) +
+          0.25 * sin(TWO_PI * 500.0 * (double)(i / n_ch) / FS + (double)(i % n_ch));
+      in_q15[i] = (int16_t)lrint(x * 32767.0);
+      in_q31[i] = (int32_t)lrint(x * 2147483647.0);
+    }
+
+    lw_biquad_q15_init(&bq15, coef_q15, state_q15, N_SECTIONS,
+                       BIQUAD_Q15_COEF_Q, n_ch);
+    calls = 0u;
+    t0 = lw_bench_now();
+    do {
+      lw_biquad_q15_process(&bq15, in_q15, out_q15, BLOCK);
+      sink += out_q15[calls % (BLOCK * n_ch)];
+      calls++;
+      t = lw_bench_now() - t0;
+    } while (t < LW_BENCH_MIN_TIME);
+    printf("%-8s %8u %14.1f\n", "q1.15", n_ch,
+           (double)calls * BLOCK * n_ch / t * 1e-6);
+
+    lw_biquad_q31_init(&bq31, coef_q31, state_q31, N_SECTIONS,
+                       BIQUAD_Q31_COEF_Q, n_ch);
+    calls = 0u;
+    t0 = lw_bench_now();
+    do {
+      lw_biquad_q31_process(&bq31, in_q31, out_q31, BLOCK);
+      sink += out_q31[calls % (BLOCK * n_ch)];
+      calls++;
+      t = lw_bench_now() - t0;
+    } while (t < LW_BENCH_MIN_TIME);
+    printf("%-8s %8u %14.1f\n", "q1.31", n_ch,
+           (double)calls * BLOCK * n_ch / t * 1e-6);
+  }
+
+  /* keeps the outputs alive */
+  printf("checksum %lld\n", (long long)sink);
+
+  return (0);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
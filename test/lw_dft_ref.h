@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * Filename              :   lw_dft_ref.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_dft_ref.h
+ *  @brief This module defines the double precision DFT the FFT test and
+ *         benchmark drivers compare against. It is evaluated with a radix-2
+ *         FFT whose twiddles come straight from cos and sin, so its error
+ *         stays near the double rounding even at 65536 points.
+ */
+
+#ifndef LW_DFT_REF_H_
+#define LW_DFT_REF_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include <stdint.h>
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define LW_DFT_REF_TWO_PI   (6.283185307179586)
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  Computes an in-place DFT in natural order, with the sign
+ *         conventions of lw_fft (forward exp(-j...), inverse exp(+j...)
+ *         without 1/N)
+ * @param  re: 2^log2n real parts
+ * @param  im: 2^log2n imaginary parts
+ * @param  log2n: base 2 logarithm of the size
+ * @param  inverse: nonzero for the inverse transform
+ */
+static inline void lw_dft_ref(double *re, double *im, uint8_t log2n, int inverse) {
+
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t i;
+  uint32_t j;
+  uint32_t k;
+  uint32_t h;
+  uint32_t b;
+  double sign = inverse ? 1.0 : -1.0;
+  double w_re;
+  double w_im;
+  double t_re;
+  double t_im;
+  double tmp;
+
+  /* bit-reversed input, then decimation in time stages */
+  for (i = 0u; i < n; i++) {
+    j = 0u;
+    for (b = 0u; b < log2n; b++) {
+      j |= ((i >> b) & 1u) << (log2n - 1u - b);
+    }
+    if (j > i) {
+      tmp = re[i];
+      re[i] = re[j];
+      re[j] = tmp;
+      tmp = im[i];
+      im[i] = im[j];
+      im[j] = tmp;
+    }
+  }
+
+  for (h = 1u; h < n; h <<= 1) {
+    for (k = 0u; k < h; k++) {
+      w_re = cos(LW_DFT_REF_TWO_PI * (double)k / (double)(2u * h));
+      w_im = sign * sin(LW_DFT_REF_TWO_PI * (double)k / (double)(2u * h));
+      for (i = k; i < n; i += 2u * h) {
+        t_re = (re[i + h] * w_re) - (im[i + h] * w_im);
+        t_im = (re[i + h] * w_im) + (im[i + h] * w_re);
+        re[i + h] = re[i] - t_re;
+        im[i + h] = im[i] - t_im;
+        re[i] += t_re;
+        im[i] += t_im;
+      }
+    }
+  }
+}
+
+/**
+ * @brief  Returns the signal to noise ratio of a result against its
+ *         reference
+ * @param  ref_re: n reference real parts
+ * @param  ref_im: n reference imaginary parts
+ * @param  re: n real parts
+ * @param  im: n imaginary parts
+ * @param  n: number of values
+ * @retval SNR in dB
+ */
+static inline double lw_dft_ref_snr(const double *ref_re, const double *ref_im,
+                                    const double *re, const double *im, uint32_t n) {
+
+  uint32_t i;
+  double sig = 0.0;
+  double err = 0.0;
+
+  for (i = 0u; i < n; i++) {
+    sig += (ref_re[i] * ref_re[i]) + (ref_im[i] * ref_im[i]);
+    err += ((re[i] - ref_re[i]) * (re[i] - ref_re[i])) +
+           ((im[i] - ref_im[i]) * (im[i] - ref_im[i]));
+  }
+
+  return (10.0 * log10(sig / ((err > 0.0) ? err : 1e-300)));
+}
+
+#endif /*LW_DFT_REF_H_*/
+
+/*** End of File *************************************************************/
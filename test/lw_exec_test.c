@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Filename              :   lw_exec_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_exec_test.c
+ *  @brief Test driver of the sharded executor: the motor states after a few
+ *         ticks must be bit-identical for any number of threads, and an
+ *         init that fails to start a worker must release the workers
+ *         already started. Linked with -Wl,--wrap=pthread_create so that
+ *         thread creation can be made to fail.
+ *
+ *  usage: lw_exec_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "lw_exec.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define N_MOTORS    (100u)    /* not a whole number of shards */
+#define N_TICKS     (5u)
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const uint32_t n_threads_list[] = {2u, 3u, 4u, 8u};
+
+static unsigned char ref_mem[LW_MOTOR_SOA_MEM_SIZE(N_MOTORS)];
+static unsigned char run_mem[LW_MOTOR_SOA_MEM_SIZE(N_MOTORS)];
+
+/* number of pthread_create calls left before the next one fails, -1 never */
+static int create_budget = -1;
+static uint32_t n_created = 0u;
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+int __real_pthread_create(pthread_t *thread, const pthread_attr_t *attr,
+                          void *(*start)(void *), void *arg);
+int __wrap_pthread_create(pthread_t *thread, const pthread_attr_t *attr,
+                          void *(*start)(void *), void *arg);
+
+static void current_stage(motor_soa_t *motors, uint32_t first, uint32_t count,
+                          void *arg);
+static int run(motor_soa_t *motors, void *mem, uint32_t n_threads);
+static int same_columns(const motor_soa_t *x, const motor_soa_t *y);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  motor_soa_t ref;
+  motor_soa_t m;
+  exec_t exec;
+  uint32_t k;
+  int err;
+
+  err = run(&ref, ref_mem, 1u);
+  lw_test_check(0 == err, "exec %u motors, 1 thread, %u ticks", N_MOTORS, N_TICKS);
+
+  for (k = 0u; k < (sizeof(n_threads_list) / sizeof(n_threads_list[0])); k++) {
+    err = run(&m, run_mem, n_threads_list[k]);
+    lw_test_check((0 == err) && same_columns(&ref, &m),
+                  "exec %u threads bit-identical to 1 thread", n_threads_list[k]);
+  }
+
+  /* the third worker fails to start: the two already running must be
+   * released through the resized barriers, or deinit never returns */
+  (void)lw_motor_soa_init(&m, run_mem, sizeof(run_mem), N_MOTORS);
+  create_budget = 2;
+  n_created = 0u;
+  err = lw_exec_init(&exec, &m, 6u, current_stage, NULL);
+  create_budget = -1;
+  lw_test_check((EAGAIN == err) && (2u == n_created),
+                "exec init failure after %u workers returns EAGAIN", n_created);
+
+  /* and the executor can be set up again */
+  err = run(&m, run_mem, 4u);
+  lw_test_check((0 == err) && same_columns(&ref, &m), "exec init after a failure");
+
+  lw_test_check(EINVAL == lw_exec_init(&exec, &m, 0u, NULL, NULL),
+                "exec init 0 threads returns EINVAL");
+  lw_test_check(EINVAL == lw_exec_init(&exec, &m, LW_EXEC_MAX_THREADS + 1u, NULL, NULL),
+                "exec init %u threads returns EINVAL", LW_EXEC_MAX_THREADS + 1u);
+
+  return (lw_test_result("lw_exec"));
+}
+
+/**
+ * @brief  pthread_create wrapper that fails with EAGAIN once the budget of
+ *         successful calls is spent
+ */
+int __wrap_pthread_create(pthread_t *thread, const pthread_attr_t *attr,
+                          void *(*start)(void *), void *arg) {
+
+  if (0 == create_budget) {
+    return (EAGAIN);
+  }
+  if (create_budget > 0) {
+    create_budget--;
+  }
+  n_created++;
+
+  return (__real_pthread_create(thread, attr, start, arg));
+}
+
+/**
+ * @brief  User stage: an integrating current controller that only touches
+ *         its own motors
+ */
+static void current_stage(motor_soa_t *motors, uint32_t first, uint32_t count,
+                          void *arg) {
+
+  uint32_t i;
+
+  (void)arg;
+
+  for (i = first; i < (first + count); i++) {
+    motors->v_q[i] = (int16_t)(motors->v_q[i] + ((1000 - motors->i_q[i]) >> 4));
+    motors->v_d[i] = (int16_t)(motors->v_d[i] - (motors->i_d[i] >> 4));
+  }
+}
+
+/**
+ * @brief  Sets up N_MOTORS motors with the same pseudo-random inputs and
+ *         runs N_TICKS ticks; the angles advance between the ticks
+ * @param  motors: container
+ * @param  mem: container memory
+ * @param  n_threads: number of threads
+ * @retval 0 on success, an errno value otherwise
+ */
+static int run(motor_soa_t *motors, void *mem, uint32_t n_threads) {
+
+  exec_t exec;
+  uint32_t seed = 12345u;
+  uint32_t i;
+  uint32_t t;
+  int err;
+
+  (void)lw_motor_soa_init(motors, mem, LW_MOTOR_SOA_MEM_SIZE(N_MOTORS), N_MOTORS);
+
+  for (i = 0u; i < N_MOTORS; i++) {
+    seed = (seed * 1103515245u) + 12345u;
+    motors->i_a[i] = (int16_t)(seed >> 17);
+    seed = (seed * 1103515245u) + 12345u;
+    motors->i_b[i] = (int16_t)(seed >> 17);
+    seed = (seed * 1103515245u) + 12345u;
+    motors->theta[i] = (int16_t)(seed >> 16);
+  }
+
+  err = lw_exec_init(&exec, motors, n_threads, current_stage, NULL);
+  if (0 != err) {
+    return (err);
+  }
+
+  for (t = 0u; t < N_TICKS; t++) {
+    lw_exec_tick(&exec);
+    for (i = 0u; i < N_MOTORS; i++) {
+      motors->theta[i] = (int16_t)(uint16_t)((uint16_t)motors->theta[i] + 1111u);
+    }
+  }
+
+  lw_exec_deinit(&exec);
+
+  return (0);
+}
+
+/**
+ * @brief  Compares the columns of two containers of N_MOTORS motors
+ * @retval nonzero when they are equal
+ */
+static int same_columns(const motor_soa_t *x, const motor_soa_t *y) {
+
+  size_t size = N_MOTORS * sizeof(int16_t);
+
+  return ((0 == memcmp(x->i_alpha, y->i_alpha, size)) &&
+          (0 == memcmp(x->i_beta, y->i_beta, size)) &&
+          (0 == memcmp(x->i_q, y->i_q, size)) &&
+          (0 == memcmp(x->i_d, y->i_d, size)) &&
+          (0 == memcmp(x->v_q, y->v_q, size)) &&
+          (0 == memcmp(x->v_d, y->v_d, size)) &&
+          (0 == memcmp(x->v_alpha, y->v_alpha, size)) &&
+          (0 == memcmp(x->v_beta, y->v_beta, size)));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,135 @@
+/******************************************************************************
+ * Filename              :   lw_fft_bench.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_fft_bench.c
+ *  @brief Benchmark driver of the fixed-point FFTs: times the forward
+ *         natural order lw_fft_q15 and lw_fft_q31 for 64 to 65536 points
+ *         and prints the SNR of each result against a double DFT of the
+ *         same quantized input (white noise at half scale)
+ *
+ *  usage: lw_fft_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "lw_fft.h"
+#include "lw_bench.h"
+#include "lw_dft_ref.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define MIN_LOG2N     (6u)
+#define MAX_N         ((uint32_t)1 << LW_FFT_MAX_LOG2N)
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static complex_q15_t in_q15[MAX_N];
+static complex_q15_t work_q15[MAX_N];
+static complex_q31_t in_q31[MAX_N];
+static complex_q31_t work_q31[MAX_N];
+static double ref_re[MAX_N];
+static double ref_im[MAX_N];
+static double out_re[MAX_N];
+static double out_im[MAX_N];
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  uint32_t seed = 1u;
+  uint32_t n;
+  uint32_t i;
+  uint32_t calls;
+  uint8_t log2n;
+  int16_t exponent = 0;
+  double t0;
+  double t;
+  double us_q15;
+  double us_q31;
+  double snr_q15;
+  double snr_q31;
+
+  for (i = 0u; i < MAX_N; i++) {
+    seed = (seed * 1103515245u) + 12345u;
+    in_q15[i].re = (int16_t)((int32_t)(seed >> 16) - 32768) / 2;
+    seed = (seed * 1103515245u) + 12345u;
+    in_q15[i].im = (int16_t)((int32_t)(seed >> 16) - 32768) / 2;
+    seed = (seed * 1103515245u) + 12345u;
+    in_q31[i].re = (int32_t)(seed - 2147483648u) / 2;
+    seed = (seed * 1103515245u) + 12345u;
+    in_q31[i].im = (int32_t)(seed - 2147483648u) / 2;
+  }
+
+  printf("%8s %12s %12s %10s %10s\n", "N", "q1.15 us", "q1.31 us",
+         "q1.15 dB", "q1.31 dB");
+
+  for (log2n = MIN_LOG2N; log2n <= LW_FFT_MAX_LOG2N; log2n++) {
+    n = (uint32_t)1 << log2n;
+
+    /* q1.15: timing without the copies of the input */
+    calls = 0u;
+    t = 0.0;
+    do {
+      memcpy(work_q15, in_q15, n * sizeof(complex_q15_t));
+      t0 = lw_bench_now();
+      (void)lw_fft_q15(work_q15, log2n, FFT_FORWARD, FFT_ORDER_NATURAL, &exponent);
+      t += lw_bench_now() - t0;
+      calls++;
+    } while (t < LW_BENCH_MIN_TIME);
+    us_q15 = t / (double)calls * 1e6;
+
+    for (i = 0u; i < n; i++) {
+      ref_re[i] = in_q15[i].re;
+      ref_im[i] = in_q15[i].im;
+      out_re[i] = ldexp((double)work_q15[i].re, exponent);
+      out_im[i] = ldexp((double)work_q15[i].im, exponent);
+    }
+    lw_dft_ref(ref_re, ref_im, log2n, 0);
+    snr_q15 = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, n);
+
+    /* q1.31 */
+    calls = 0u;
+    t = 0.0;
+    do {
+      memcpy(work_q31, in_q31, n * sizeof(complex_q31_t));
+      t0 = lw_bench_now();
+      (void)lw_fft_q31(work_q31, log2n, FFT_FORWARD, FFT_ORDER_NATURAL, &exponent);
+      t += lw_bench_now() - t0;
+      calls++;
+    } while (t < LW_BENCH_MIN_TIME);
+    us_q31 = t / (double)calls * 1e6;
+
+    for (i = 0u; i < n; i++) {
+      ref_re[i] = in_q31[i].re;
+      ref_im[i] = in_q31[i].im;
+      out_re[i] = ldexp((double)work_q31[i].re, exponent);
+      out_im[i] = ldexp((double)work_q31[i].im, exponent);
+    }
+    lw_dft_ref(ref_re, ref_im, log2n, 0);
+    snr_q31 = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, n);
+
+    printf("%8u %12.2f %12.2f %10.1f %10.1f\n", n, us_q15, us_q31, snr_q15,
+           snr_q31);
+  }
+
+  return (0);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,251 @@
+/******************************************************************************
+ * Filename              :   lw_fft_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_fft_test.c
+ *  @brief Test driver of the fixed-point FFTs against a double DFT: forward
+ *         SNR, forward and inverse round trip through the block exponents,
+ *         bit-reversed against natural order, the blocked path above 1024
+ *         points and the size checks
+ *
+ *  usage: lw_fft_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include <string.h>
+#include "lw_fft.h"
+#include "lw_dft_ref.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define MAX_LOG2N       (12u)     /* two blocks of 2048 points run blocked */
+#define MAX_N           ((uint32_t)1 << MAX_LOG2N)
+
+/* smallest accepted SNR in dB of the forward transform and of the round
+ * trip; the q1.31 path is limited by the q1.15 twiddles. A block exponent
+ * off by one bit brings the SNR down to about 0 dB. */
+#define MIN_SNR_Q15     (45.0)
+#define MIN_SNR_Q31     (65.0)
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Test signal type definition
+ */
+typedef enum {
+  SIGNAL_NOISE = 0,     /**< white noise at half scale */
+  SIGNAL_TONE           /**< one full scale tone: the blocks get different exponents */
+} signal_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const uint8_t log2n_list[] = {1u, 2u, 3u, 6u, 10u, 11u, 12u};
+
+static complex_q15_t in_q15[MAX_N];
+static complex_q15_t x_q15[MAX_N];
+static complex_q15_t y_q15[MAX_N];
+static complex_q31_t in_q31[MAX_N];
+static complex_q31_t x_q31[MAX_N];
+static complex_q31_t y_q31[MAX_N];
+static double ref_re[MAX_N];
+static double ref_im[MAX_N];
+static double out_re[MAX_N];
+static double out_im[MAX_N];
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void make_input(signal_t signal, uint8_t log2n);
+static void test_q15(signal_t signal, uint8_t log2n);
+static void test_q31(signal_t signal, uint8_t log2n);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  uint32_t k;
+  int16_t exponent;
+
+  for (k = 0u; k < (sizeof(log2n_list) / sizeof(log2n_list[0])); k++) {
+    test_q15(SIGNAL_NOISE, log2n_list[k]);
+    test_q31(SIGNAL_NOISE, log2n_list[k]);
+  }
+  test_q15(SIGNAL_TONE, MAX_LOG2N);
+  test_q31(SIGNAL_TONE, MAX_LOG2N);
+
+  lw_test_check(EINVAL == lw_fft_q15(x_q15, 0u, FFT_FORWARD, FFT_ORDER_NATURAL, &exponent),
+                "fft q15 log2n 0 returns EINVAL");
+  lw_test_check(EINVAL == lw_fft_q15(x_q15, LW_FFT_MAX_LOG2N + 1u, FFT_FORWARD,
+                                     FFT_ORDER_NATURAL, &exponent),
+                "fft q15 log2n %u returns EINVAL", LW_FFT_MAX_LOG2N + 1u);
+  lw_test_check(EINVAL == lw_fft_q31(x_q31, 0u, FFT_FORWARD, FFT_ORDER_NATURAL, &exponent),
+                "fft q31 log2n 0 returns EINVAL");
+  lw_test_check(EINVAL == lw_fft_q31(x_q31, LW_FFT_MAX_LOG2N + 1u, FFT_FORWARD,
+                                     FFT_ORDER_NATURAL, &exponent),
+                "fft q31 log2n %u returns EINVAL", LW_FFT_MAX_LOG2N + 1u);
+
+  return (lw_test_result("lw_fft"));
+}
+
+/**
+ * @brief  Fills in_q15 and in_q31 with the test signal
+ * @param  signal: test signal
+ * @param  log2n: base 2 logarithm of the size
+ */
+static void make_input(signal_t signal, uint8_t log2n) {
+
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t seed = 7u;
+  uint32_t i;
+  double phase;
+
+  for (i = 0u; i < n; i++) {
+    if (SIGNAL_TONE == signal) {
+      phase = LW_DFT_REF_TWO_PI * 37.0 * (double)i / (double)n;
+      in_q15[i].re = (int16_t)lrint(32000.0 * cos(phase));
+      in_q15[i].im = (int16_t)lrint(32000.0 * sin(phase));
+      in_q31[i].re = (int32_t)lrint(2147000000.0 * cos(phase));
+      in_q31[i].im = (int32_t)lrint(2147000000.0 * sin(phase));
+    }
+    else {
+      seed = (seed * 1103515245u) + 12345u;
+      in_q15[i].re = (int16_t)(((int32_t)(seed >> 16) - 32768) / 2);
+      seed = (seed * 1103515245u) + 12345u;
+      in_q15[i].im = (int16_t)(((int32_t)(seed >> 16) - 32768) / 2);
+      seed = (seed * 1103515245u) + 12345u;
+      in_q31[i].re = (int32_t)(seed - 2147483648u) / 2;
+      seed = (seed * 1103515245u) + 12345u;
+      in_q31[i].im = (int32_t)(seed - 2147483648u) / 2;
+    }
+  }
+}
+
+/**
+ * @brief  Runs the q1.15 checks of one signal and size
+ * @param  signal: test signal
+ * @param  log2n: base 2 logarithm of the size
+ */
+static void test_q15(signal_t signal, uint8_t log2n) {
+
+  const char *name = (SIGNAL_TONE == signal) ? "tone" : "noise";
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t i;
+  int16_t exp_fwd = 0;
+  int16_t exp_inv = 0;
+  int16_t exp_rev = 0;
+  int err;
+  double snr;
+
+  make_input(signal, log2n);
+
+  /* forward, natural order, against the double DFT */
+  memcpy(x_q15, in_q15, n * sizeof(complex_q15_t));
+  err = lw_fft_q15(x_q15, log2n, FFT_FORWARD, FFT_ORDER_NATURAL, &exp_fwd);
+  for (i = 0u; i < n; i++) {
+    ref_re[i] = in_q15[i].re;
+    ref_im[i] = in_q15[i].im;
+    out_re[i] = ldexp((double)x_q15[i].re, exp_fwd);
+    out_im[i] = ldexp((double)x_q15[i].im, exp_fwd);
+  }
+  lw_dft_ref(ref_re, ref_im, log2n, 0);
+  snr = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, n);
+  lw_test_check((0 == err) && (snr >= MIN_SNR_Q15),
+                "fft q15 %-5s N=%-5u forward SNR %.1f dB, exponent %d", name, n,
+                snr, exp_fwd);
+
+  /* bit-reversed order, then the permutation: same data, same exponent */
+  memcpy(y_q15, in_q15, n * sizeof(complex_q15_t));
+  err = lw_fft_q15(y_q15, log2n, FFT_FORWARD, FFT_ORDER_BITREV, &exp_rev);
+  lw_fft_bitrev_q15(y_q15, log2n);
+  lw_test_check((0 == err) && (exp_rev == exp_fwd) &&
+                (0 == memcmp(x_q15, y_q15, n * sizeof(complex_q15_t))),
+                "fft q15 %-5s N=%-5u bit-reversed order matches natural", name, n);
+
+  /* inverse of the forward result: x * N * 2^-(exp_fwd + exp_inv) */
+  err = lw_fft_q15(x_q15, log2n, FFT_INVERSE, FFT_ORDER_NATURAL, &exp_inv);
+  for (i = 0u; i < n; i++) {
+    ref_re[i] = in_q15[i].re;
+    ref_im[i] = in_q15[i].im;
+    out_re[i] = ldexp((double)x_q15[i].re, exp_fwd + exp_inv - (int)log2n);
+    out_im[i] = ldexp((double)x_q15[i].im, exp_fwd + exp_inv - (int)log2n);
+  }
+  snr = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, n);
+  lw_test_check((0 == err) && (snr >= MIN_SNR_Q15),
+                "fft q15 %-5s N=%-5u round trip SNR %.1f dB, exponent %d", name,
+                n, snr, exp_fwd + exp_inv);
+}
+
+/**
+ * @brief  Runs the q1.31 checks of one signal and size
+ * @param  signal: test signal
+ * @param  log2n: base 2 logarithm of the size
+ */
+static void test_q31(signal_t signal, uint8_t log2n) {
+
+  const char *name = (SIGNAL_TONE == signal) ? "tone" : "noise";
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t i;
+  int16_t exp_fwd = 0;
+  int16_t exp_inv = 0;
+  int16_t exp_rev = 0;
+  int err;
+  double snr;
+
+  make_input(signal, log2n);
+
+  /* forward, natural order, against the double DFT */
+  memcpy(x_q31, in_q31, n * sizeof(complex_q31_t));
+  err = lw_fft_q31(x_q31, log2n, FFT_FORWARD, FFT_ORDER_NATURAL, &exp_fwd);
+  for (i = 0u; i < n; i++) {
+    ref_re[i] = in_q31[i].re;
+    ref_im[i] = in_q31[i].im;
+    out_re[i] = ldexp((double)x_q31[i].re, exp_fwd);
+    out_im[i] = ldexp((double)x_q31[i].im, exp_fwd);
+  }
+  lw_dft_ref(ref_re, ref_im, log2n, 0);
+  snr = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, n);
+  lw_test_check((0 == err) && (snr >= MIN_SNR_Q31),
+                "fft q31 %-5s N=%-5u forward SNR %.1f dB, exponent %d", name, n,
+                snr, exp_fwd);
+
+  /* bit-reversed order, then the permutation: same data, same exponent */
+  memcpy(y_q31, in_q31, n * sizeof(complex_q31_t));
+  err = lw_fft_q31(y_q31, log2n, FFT_FORWARD, FFT_ORDER_BITREV, &exp_rev);
+  lw_fft_bitrev_q31(y_q31, log2n);
+  lw_test_check((0 == err) && (exp_rev == exp_fwd) &&
+                (0 == memcmp(x_q31, y_q31, n * sizeof(complex_q31_t))),
+                "fft q31 %-5s N=%-5u bit-reversed order matches natural", name, n);
+
+  /* inverse of the forward result: x * N * 2^-(exp_fwd + exp_inv) */
+  err = lw_fft_q31(x_q31, log2n, FFT_INVERSE, FFT_ORDER_NATURAL, &exp_inv);
+  for (i = 0u; i < n; i++) {
+    ref_re[i] = in_q31[i].re;
+    ref_im[i] = in_q31[i].im;
+    out_re[i] = ldexp((double)x_q31[i].re, exp_fwd + exp_inv - (int)log2n);
+    out_im[i] = ldexp((double)x_q31[i].im, exp_fwd + exp_inv - (int)log2n);
+  }
+  snr = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, n);
+  lw_test_check((0 == err) && (snr >= MIN_SNR_Q31),
+                "fft q31 %-5s N=%-5u round trip SNR %.1f dB, exponent %d", name,
+                n, snr, exp_fwd + exp_inv);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,267 @@
+/******************************************************************************
+ * Filename              :   lw_goertzel_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_goertzel_test.c
+ *  @brief Test driver of the Goertzel bin bank against a double DFT: the
+ *         amplitude and phase of low, pi/4, near pi/2 and Nyquist bins over
+ *         an 8192-sample window, the leakage into the other bins, and the
+ *         window cap at 65536 samples
+ *
+ *  usage: lw_goertzel_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <string.h>
+#include "lw_goertzel.h"
+#include "lw_dft_ref.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define LOG2N           (13u)         /* 8192 samples, the documented range */
+#define LOG2N_CAP       (16u)         /* GOERTZEL_MAX_WINDOW samples */
+#define N_CAP           ((uint32_t)1 << LOG2N_CAP)
+#define N_EXTRA         (1000u)       /* samples fed past the cap */
+#define BLOCK           (1000u)       /* samples per call, not a divisor of N */
+#define N_BINS          (7u)
+#define A_TONE          (30000.0)
+#define A_NYQUIST       (16000.0)     /* the Nyquist bin reads twice the amplitude */
+#define PHASE           (1.0)         /* rad at the first sample */
+
+/* largest accepted relative amplitude error and phase error in rad of the
+ * bin of a tone: a tuning error of 2^-14 rad per sample turns the phase by
+ * up to 0.25 rad over 8192 samples. The same error leaks a tone two steps
+ * away by about 0.5% of its amplitude, TOL_LEAK is relative too. */
+#define TOL_AMP         (1e-2)
+#define TOL_PHASE       (0.25)
+#define TOL_LEAK        (1e-2)
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Bin under test type definition
+ */
+typedef struct {
+  int16_t angle;        /**< angle per sample in q1.15 format, a table step */
+  const char *name;     /**< description */
+} bin_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/* the half angle path runs up to pi/4 and the direct reads above it; step
+ * 385 has the largest phase error over [0, pi] */
+static const bin_t bin_list[N_BINS] = {
+  {64, "low, one step"}, {320, "low, five steps"}, {8128, "mid, below pi/4"},
+  {8256, "mid, above pi/4"}, {16320, "near pi/2"}, {24640, "step 385"},
+  {INT16_MIN, "Nyquist"},
+};
+
+static int32_t coef_cos[N_BINS];
+static int32_t coef_sin[N_BINS];
+static int64_t state1[N_BINS];
+static int64_t state2[N_BINS];
+static int16_t input[N_CAP + N_EXTRA];
+static double ref_re[N_CAP];
+static double ref_im[N_CAP];
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void feed(goertzel_t *g, uint32_t n);
+static void reference(uint8_t log2n, int16_t angle, double *re, double *im);
+static void test_tone(goertzel_t *g, uint32_t tone);
+static void test_cap(goertzel_t *g);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  goertzel_t g;
+  uint32_t i;
+
+  lw_goertzel_init(&g, coef_cos, coef_sin, state1, state2, N_BINS);
+  for (i = 0u; i < N_BINS; i++) {
+    lw_goertzel_set_bin(&g, i, bin_list[i].angle);
+  }
+
+  for (i = 0u; i < N_BINS; i++) {
+    test_tone(&g, i);
+  }
+  test_cap(&g);
+
+  return (lw_test_result("lw_goertzel"));
+}
+
+/**
+ * @brief  Clears the window and feeds the first n input samples in blocks
+ * @param  g: bank of bins
+ * @param  n: number of samples
+ */
+static void feed(goertzel_t *g, uint32_t n) {
+
+  uint32_t done;
+  uint32_t len;
+
+  lw_goertzel_reset(g);
+  for (done = 0u; done < n; done += len) {
+    len = ((n - done) < BLOCK) ? (n - done) : BLOCK;
+    lw_goertzel_process(g, &input[done], len);
+  }
+}
+
+/**
+ * @brief  Returns the expected output of one bin from the DFT of the
+ *         input in ref_re and ref_im: 2 / N * X[m] * exp(jw(N - 1)), the
+ *         phase moved to the last sample
+ * @param  log2n: base 2 logarithm of the window
+ * @param  angle: angle of the bin in q1.15 format
+ * @param  re: expected real part
+ * @param  im: expected imaginary part
+ */
+static void reference(uint8_t log2n, int16_t angle, double *re, double *im) {
+
+  uint32_t n = (uint32_t)1 << log2n;
+  int32_t w_q15 = (angle < 0) ? -(int32_t)angle : (int32_t)angle;
+  uint32_t m = ((uint32_t)w_q15 << log2n) >> 16;
+  double w = LW_DFT_REF_TWO_PI * (double)w_q15 / 65536.0;
+  double turn = w * (double)(n - 1u);
+
+  *re = 2.0 * ((ref_re[m] * cos(turn)) - (ref_im[m] * sin(turn))) / (double)n;
+  *im = 2.0 * ((ref_re[m] * sin(turn)) + (ref_im[m] * cos(turn))) / (double)n;
+  *im = (angle < 0) ? -*im : *im;
+}
+
+/**
+ * @brief  Feeds a tone at one bin to the whole bank: its bin must read the
+ *         amplitude and phase of the DFT, the others must stay near zero
+ * @param  g: bank of bins
+ * @param  tone: index of the bin of the tone
+ */
+static void test_tone(goertzel_t *g, uint32_t tone) {
+
+  uint32_t n = (uint32_t)1 << LOG2N;
+  int16_t angle = bin_list[tone].angle;
+  double a = (INT16_MIN == angle) ? A_NYQUIST : A_TONE;
+  double w = LW_DFT_REF_TWO_PI * (double)((angle < 0) ? -(int32_t)angle : angle) / 65536.0;
+  double leak = 0.0;
+  double re;
+  double im;
+  double amp_err;
+  double phase_err;
+  goertzel_out_t out;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    input[i] = (int16_t)lrint(a * cos((w * (double)i) + PHASE));
+    ref_re[i] = input[i];
+    ref_im[i] = 0.0;
+  }
+  lw_dft_ref(ref_re, ref_im, LOG2N, 0);
+  feed(g, n);
+
+  for (i = 0u; i < N_BINS; i++) {
+    if (i != tone) {
+      reference(LOG2N, bin_list[i].angle, &re, &im);
+      out = lw_goertzel_get(g, i);
+      leak = fmax(leak, hypot(out.re - re, out.im - im));
+    }
+  }
+
+  reference(LOG2N, angle, &re, &im);
+  out = lw_goertzel_get(g, tone);
+  amp_err = ((double)out.amplitude / hypot(re, im)) - 1.0;
+  phase_err = remainder(atan2(out.im, out.re) - atan2(im, re), LW_DFT_REF_TWO_PI);
+
+  lw_test_check((fabs(amp_err) <= TOL_AMP) && (fabs(phase_err) <= TOL_PHASE) &&
+                (leak <= (TOL_LEAK * a)),
+                "goertzel angle %6d %-18s N=%u amplitude %+.2f%%, phase %+.3f rad, "
+                "leakage %.1f LSB", angle, bin_list[tone].name, n, 100.0 * amp_err,
+                phase_err, leak);
+}
+
+/**
+ * @brief  Fills a window of GOERTZEL_MAX_WINDOW samples with a dc level and
+ *         tones at the low, near pi/2 and Nyquist bins, then feeds more samples:
+ *         the largest states must not overflow and the later samples must
+ *         be ignored
+ * @param  g: bank of bins
+ */
+static void test_cap(goertzel_t *g) {
+
+  static const uint32_t cap_bins[] = {0u, 4u, 6u};
+  goertzel_out_t before[N_BINS];
+  goertzel_out_t after[N_BINS];
+  goertzel_out_t out;
+  double w_low = LW_DFT_REF_TWO_PI * (double)bin_list[0].angle / 65536.0;
+  double w_high = LW_DFT_REF_TWO_PI * (double)bin_list[4].angle / 65536.0;
+  uint32_t i;
+  uint32_t k;
+  double re;
+  double im;
+  double amp_err;
+  double phase_err;
+
+  /* bin 1 goes to dc: N^2 * A / 2 is the largest state */
+  lw_goertzel_set_bin(g, 1u, 0);
+
+  for (i = 0u; i < (N_CAP + N_EXTRA); i++) {
+    input[i] = (int16_t)lrint(10000.0 + (8000.0 * cos((w_low * (double)i) + PHASE)) +
+                              (6000.0 * cos((w_high * (double)i) + PHASE)) +
+                              ((0u == (i & 1u)) ? 4000.0 : -4000.0));
+    if (i < N_CAP) {
+      ref_re[i] = input[i];
+      ref_im[i] = 0.0;
+    }
+  }
+  lw_dft_ref(ref_re, ref_im, LOG2N_CAP, 0);
+
+  feed(g, N_CAP);
+  for (i = 0u; i < N_BINS; i++) {
+    before[i] = lw_goertzel_get(g, i);
+  }
+  lw_goertzel_process(g, &input[N_CAP], N_EXTRA);
+  for (i = 0u; i < N_BINS; i++) {
+    after[i] = lw_goertzel_get(g, i);
+  }
+
+  /* the dc bin is exact: re = 2 * sum / N */
+  out = lw_goertzel_get(g, 1u);
+  lw_test_check((20000 == out.re) && (0 == out.im),
+                "goertzel dc bin over %u samples reads %d %+d (expected 20000 +0)",
+                N_CAP, out.re, out.im);
+
+  for (k = 0u; k < (sizeof(cap_bins) / sizeof(cap_bins[0])); k++) {
+    i = cap_bins[k];
+    reference(LOG2N_CAP, bin_list[i].angle, &re, &im);
+    out = lw_goertzel_get(g, i);
+    amp_err = ((double)out.amplitude / hypot(re, im)) - 1.0;
+    phase_err = remainder(atan2(out.im, out.re) - atan2(im, re), LW_DFT_REF_TWO_PI);
+    lw_test_check((fabs(amp_err) <= TOL_AMP) && (fabs(phase_err) <= TOL_PHASE),
+                  "goertzel angle %6d %-18s N=%u amplitude %+.2f%%, phase %+.3f rad",
+                  bin_list[i].angle, bin_list[i].name, N_CAP, 100.0 * amp_err, phase_err);
+  }
+
+  lw_test_check((GOERTZEL_MAX_WINDOW == g->count) &&
+                (0 == memcmp(before, after, sizeof(before))),
+                "goertzel window capped at %u samples, %u later ones ignored", g->count,
+                N_EXTRA);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
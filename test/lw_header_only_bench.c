@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Filename              :   lw_header_only_bench.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_header_only_bench.c
+ *  @brief Benchmark driver of the header-only build of lw_math: the same
+ *         per-sample Clarke, Park and trigonometry loop over 4096 samples,
+ *         calling the library in lw_math.o and inlined with
+ *         LW_MATH_HEADER_ONLY, reported in ns per sample. This file is
+ *         compiled twice: with LW_MATH_HEADER_ONLY it only defines
+ *         bench_loop_ho, otherwise bench_loop_c and the driver.
+ *
+ *  usage: lw_header_only_bench
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include "lw_math.h"
+#ifndef LW_MATH_HEADER_ONLY
+#include "lw_bench.h"
+#endif
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define N_SAMPLES     (4096u)
+
+#ifdef LW_MATH_HEADER_ONLY
+#define BENCH_LOOP    bench_loop_ho
+#else
+#define BENCH_LOOP    bench_loop_c
+#endif
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+int32_t bench_loop_c(const ab_t *input, const int16_t *theta, uint32_t n);
+int32_t bench_loop_ho(const ab_t *input, const int16_t *theta, uint32_t n);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  Clarke and Park of every sample, plus the trigonometry of the
+ *         angle, one call per function as a control loop does
+ * @param  input: array of n phase currents
+ * @param  theta: array of n angles in q1.15 format
+ * @param  n: number of samples
+ * @retval sum of the results, compared between the builds
+ */
+int32_t BENCH_LOOP(const ab_t *input, const int16_t *theta, uint32_t n) {
+
+  uint32_t i;
+  int32_t sum = 0;
+  qd_t qd;
+  trig_components_t trig;
+
+  for (i = 0u; i < n; i++) {
+    qd = lw_math_park(lw_math_clarke(input[i]), theta[i]);
+    trig = lw_math_trig_functions(theta[i]);
+    sum += qd.q + qd.d + trig.cos + trig.sin;
+  }
+
+  return (sum);
+}
+
+#ifndef LW_MATH_HEADER_ONLY
+
+static ab_t input[N_SAMPLES];
+static int16_t theta[N_SAMPLES];
+
+/**
+ * @brief  Times one build of the loop
+ * @param  loop: loop under test
+ * @param  sum: sum of the results of one pass
+ * @retval time per sample in ns
+ */
+static double bench_time(int32_t (*loop)(const ab_t *, const int16_t *, uint32_t),
+                         int32_t *sum) {
+
+  uint32_t calls = 0u;
+  double t0;
+  double t;
+  volatile int32_t sink = 0;
+
+  t0 = lw_bench_now();
+  do {
+    sink += loop(input, theta, N_SAMPLES);
+    calls++;
+    t = lw_bench_now() - t0;
+  } while (t < LW_BENCH_MIN_TIME);
+
+  *sum = loop(input, theta, N_SAMPLES);
+
+  return (t / ((double)calls * N_SAMPLES) * 1e9);
+}
+
+int main(void) {
+
+  uint32_t seed = 1u;
+  uint32_t i;
+  int32_t sum_c;
+  int32_t sum_ho;
+  double ns_c;
+  double ns_ho;
+
+  for (i = 0u; i < N_SAMPLES; i++) {
+    seed = (seed * 1103515245u) + 12345u;
+    input[i].a = (int16_t)((int32_t)(seed >> 16) - 32768) / 2;
+    seed = (seed * 1103515245u) + 12345u;
+    input[i].b = (int16_t)((int32_t)(seed >> 16) - 32768) / 2;
+    theta[i] = (int16_t)(uint16_t)(i * 97u);
+  }
+
+  ns_c = bench_time(bench_loop_c, &sum_c);
+  ns_ho = bench_time(bench_loop_ho, &sum_ho);
+
+  printf("%-12s %12s\n", "build", "ns/sample");
+  printf("%-12s %12.2f\n", "library", ns_c);
+  printf("%-12s %12.2f\n", "header-only", ns_ho);
+
+  if (sum_c != sum_ho) {
+    printf("FAIL the builds disagree: %ld != %ld\n", (long)sum_c, (long)sum_ho);
+    return (1);
+  }
+
+  return (0);
+}
+
+#endif /*LW_MATH_HEADER_ONLY*/
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,53 @@
+/******************************************************************************
+ * Filename              :   lw_math_ref_constexpr.cpp
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_ref_constexpr.cpp
+ *  @brief This module exports the constexpr functions of lw_math.hpp to
+ *         the C differential test driver
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_math.hpp"
+#include "lw_math_ref_variants.h"
+
+/* the functions must stay usable in constant expressions */
+static_assert(lw_math::sqrt(1048576) == 1024, "constexpr sqrt");
+static_assert(lw_math::clarke({1000, 0}).alpha == 1000, "constexpr clarke");
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+trig_components_t lw_math_cx_trig_functions(int16_t angle) {
+  return (lw_math::trig_functions(angle));
+}
+
+int32_t lw_math_cx_sqrt(int32_t input) {
+  return (lw_math::sqrt(input));
+}
+
+int16_t lw_math_cx_atan2(int16_t y, int16_t x) {
+  return (lw_math::atan2(y, x));
+}
+
+alphabeta_t lw_math_cx_clarke(ab_t input) {
+  return (lw_math::clarke(input));
+}
+
+qd_t lw_math_cx_park(alphabeta_t input, int16_t theta) {
+  return (lw_math::park(input, theta));
+}
+
+alphabeta_t lw_math_cx_rev_park(qd_t input, int16_t theta) {
+  return (lw_math::rev_park(input, theta));
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Filename              :   lw_math_ref_header_only.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_ref_header_only.c
+ *  @brief This module exports the LW_MATH_HEADER_ONLY build of the lw_math
+ *         functions, whose static inline copies are private to this file
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#define LW_MATH_HEADER_ONLY
+#include "lw_math.h"
+#include "lw_math_ref_variants.h"
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+trig_components_t lw_math_ho_trig_functions(int16_t angle) {
+  return (lw_math_trig_functions(angle));
+}
+
+int32_t lw_math_ho_sqrt(int32_t input) {
+  return (lw_math_sqrt(input));
+}
+
+int16_t lw_math_ho_atan2(int16_t y, int16_t x) {
+  return (lw_math_atan2(y, x));
+}
+
+alphabeta_t lw_math_ho_clarke(ab_t input) {
+  return (lw_math_clarke(input));
+}
+
+qd_t lw_math_ho_park(alphabeta_t input, int16_t theta) {
+  return (lw_math_park(input, theta));
+}
+
+alphabeta_t lw_math_ho_rev_park(qd_t input, int16_t theta) {
+  return (lw_math_rev_park(input, theta));
+}
+
+void lw_math_ho_park_multi(alphabeta_t input, int16_t theta,
+                           const int8_t *orders, qd_t *output,
+                           uint8_t n_frames) {
+  lw_math_park_multi(input, theta, orders, output, n_frames);
+}
+
+void lw_math_ho_clarke_soa(const int16_t *a, const int16_t *b, int16_t *alpha,
+                           int16_t *beta, uint32_t n) {
+  lw_math_clarke_soa(a, b, alpha, beta, n);
+}
+
+void lw_math_ho_park_soa(const int16_t *alpha, const int16_t *beta,
+                         const int16_t *theta, int16_t *q, int16_t *d,
+                         uint32_t n) {
+  lw_math_park_soa(alpha, beta, theta, q, d, n);
+}
+
+void lw_math_ho_rev_park_soa(const int16_t *q, const int16_t *d,
+                             const int16_t *theta, int16_t *alpha,
+                             int16_t *beta, uint32_t n) {
+  lw_math_rev_park_soa(q, d, theta, alpha, beta, n);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,229 @@
+/******************************************************************************
+ * Filename              :   lw_math_ref_main.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_ref_main.c
+ *  @brief Differential test driver: runs every build of the lw_math
+ *         functions (C library, header-only, constexpr, batched and
+ *         structure of arrays, with and without precomputed cos and sin)
+ *         against the lw_math_ref models, prints the
+ *         error statistics and fails when an error bound is exceeded or a
+ *         build disagrees with the C library
+ *
+ *  usage: lw_math_ref_test [n_random [seed]]
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "lw_math.h"
+#include "lw_math_ref.h"
+#include "lw_math_ref_variants.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define DEFAULT_N_RANDOM  1000000u
+
+/* largest errors accepted, in LSB. The trigonometric table is read one step
+ * off in the mirrored quadrants, which costs up to 201 LSB on trig and on
+ * the transforms built on it */
+#define TOL_TRIG      202.0
+#define TOL_SQRT      1.0
+#define TOL_ATAN2     4.0
+#define TOL_CLARKE    3.0
+#define TOL_PARK      203.0
+
+/* largest block the structure of arrays checks feed */
+#define TRIG_BLOCK    256u
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static uint32_t n_failed = 0u;
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void report(const char *name, const char *variant,
+                   const ref_stats_t *stats, const ref_stats_t *base,
+                   double tol);
+static void park_trig_soa(const int16_t *alpha, const int16_t *beta,
+                          const int16_t *theta, int16_t *q, int16_t *d,
+                          uint32_t n);
+static void rev_park_trig_soa(const int16_t *q, const int16_t *d,
+                              const int16_t *theta, int16_t *alpha,
+                              int16_t *beta, uint32_t n);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(int argc, char *argv[]) {
+
+  uint32_t n = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : DEFAULT_N_RANDOM;
+  uint32_t seed = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 0u;
+  ref_stats_t c;
+  ref_stats_t s;
+
+  printf("%-14s %-12s %9s %9s %9s %9s  %s\n", "function", "variant", "samples",
+         "max", "mean", "rms", "worst input");
+
+  lw_math_ref_check_trig(lw_math_trig_functions, &c);
+  report("trig", "c", &c, NULL, TOL_TRIG);
+  lw_math_ref_check_trig(lw_math_ho_trig_functions, &s);
+  report("trig", "header-only", &s, &c, TOL_TRIG);
+  lw_math_ref_check_trig(lw_math_cx_trig_functions, &s);
+  report("trig", "constexpr", &s, &c, TOL_TRIG);
+
+  lw_math_ref_check_sqrt(lw_math_sqrt, n, seed, &c);
+  report("sqrt", "c", &c, NULL, TOL_SQRT);
+  lw_math_ref_check_sqrt(lw_math_ho_sqrt, n, seed, &s);
+  report("sqrt", "header-only", &s, &c, TOL_SQRT);
+  lw_math_ref_check_sqrt(lw_math_cx_sqrt, n, seed, &s);
+  report("sqrt", "constexpr", &s, &c, TOL_SQRT);
+
+  lw_math_ref_check_atan2(lw_math_atan2, n, seed, &c);
+  report("atan2", "c", &c, NULL, TOL_ATAN2);
+  lw_math_ref_check_atan2(lw_math_ho_atan2, n, seed, &s);
+  report("atan2", "header-only", &s, &c, TOL_ATAN2);
+  lw_math_ref_check_atan2(lw_math_cx_atan2, n, seed, &s);
+  report("atan2", "constexpr", &s, &c, TOL_ATAN2);
+
+  lw_math_ref_check_clarke(lw_math_clarke, n, seed, &c);
+  report("clarke", "c", &c, NULL, TOL_CLARKE);
+  lw_math_ref_check_clarke(lw_math_ho_clarke, n, seed, &s);
+  report("clarke", "header-only", &s, &c, TOL_CLARKE);
+  lw_math_ref_check_clarke(lw_math_cx_clarke, n, seed, &s);
+  report("clarke", "constexpr", &s, &c, TOL_CLARKE);
+  lw_math_ref_check_clarke_soa(lw_math_clarke_soa, n, seed, &s);
+  report("clarke_soa", "c", &s, &c, TOL_CLARKE);
+  lw_math_ref_check_clarke_soa(lw_math_ho_clarke_soa, n, seed, &s);
+  report("clarke_soa", "header-only", &s, &c, TOL_CLARKE);
+
+  lw_math_ref_check_park(lw_math_park, n, seed, &c);
+  report("park", "c", &c, NULL, TOL_PARK);
+  lw_math_ref_check_park(lw_math_ho_park, n, seed, &s);
+  report("park", "header-only", &s, &c, TOL_PARK);
+  lw_math_ref_check_park(lw_math_cx_park, n, seed, &s);
+  report("park", "constexpr", &s, &c, TOL_PARK);
+  lw_math_ref_check_park_soa(lw_math_park_soa, n, seed, &s);
+  report("park_soa", "c", &s, &c, TOL_PARK);
+  lw_math_ref_check_park_soa(lw_math_ho_park_soa, n, seed, &s);
+  report("park_soa", "header-only", &s, &c, TOL_PARK);
+  lw_math_ref_check_park_soa(park_trig_soa, n, seed, &s);
+  report("park_soa", "trig", &s, &c, TOL_PARK);
+  lw_math_ref_check_park_multi(lw_math_park_multi, n, seed, &c);
+  report("park_multi", "c", &c, NULL, TOL_PARK);
+  lw_math_ref_check_park_multi(lw_math_ho_park_multi, n, seed, &s);
+  report("park_multi", "header-only", &s, &c, TOL_PARK);
+
+  lw_math_ref_check_rev_park(lw_math_rev_park, n, seed, &c);
+  report("rev_park", "c", &c, NULL, TOL_PARK);
+  lw_math_ref_check_rev_park(lw_math_ho_rev_park, n, seed, &s);
+  report("rev_park", "header-only", &s, &c, TOL_PARK);
+  lw_math_ref_check_rev_park(lw_math_cx_rev_park, n, seed, &s);
+  report("rev_park", "constexpr", &s, &c, TOL_PARK);
+  lw_math_ref_check_rev_park_soa(lw_math_rev_park_soa, n, seed, &s);
+  report("rev_park_soa", "c", &s, &c, TOL_PARK);
+  lw_math_ref_check_rev_park_soa(lw_math_ho_rev_park_soa, n, seed, &s);
+  report("rev_park_soa", "header-only", &s, &c, TOL_PARK);
+  lw_math_ref_check_rev_park_soa(rev_park_trig_soa, n, seed, &s);
+  report("rev_park_soa", "trig", &s, &c, TOL_PARK);
+
+  printf("%s: %u check(s) failed\n", (0u == n_failed) ? "PASS" : "FAIL", n_failed);
+
+  return (0u == n_failed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief  Prints the statistics of one check and counts it as failed when
+ *         the largest error exceeds the bound or, for a build compared with
+ *         another one on the same inputs, when the statistics differ
+ * @param  name: function name
+ * @param  variant: build name
+ * @param  stats: statistics of the check
+ * @param  base: statistics of the same inputs through the scalar C
+ *         library function, or NULL
+ * @param  tol: largest accepted error in LSB
+ */
+static void report(const char *name, const char *variant,
+                   const ref_stats_t *stats, const ref_stats_t *base,
+                   double tol) {
+
+  const char *verdict = "ok";
+
+  if (stats->max_abs_err > tol) {
+    verdict = "FAIL: error bound";
+  }
+  else if ((NULL != base) && ((stats->n != base->n) ||
+           (stats->max_abs_err != base->max_abs_err) ||
+           (stats->mean_err != base->mean_err) ||
+           (stats->rms_err != base->rms_err))) {
+    verdict = "FAIL: differs from the C library";
+  }
+  else {
+    /* passed */
+  }
+
+  if ('o' != verdict[0]) {
+    n_failed++;
+  }
+
+  printf("%-14s %-12s %9u %9.2f %9.3f %9.3f  (%ld, %ld, %ld) %s\n", name,
+         variant, stats->n, stats->max_abs_err, stats->mean_err,
+         stats->rms_err, (long)stats->worst_input[0],
+         (long)stats->worst_input[1], (long)stats->worst_input[2], verdict);
+}
+
+/**
+ * @brief  lw_math_park_trig_soa fed with the cosines and sines of theta
+ */
+static void park_trig_soa(const int16_t *alpha, const int16_t *beta,
+                          const int16_t *theta, int16_t *q, int16_t *d,
+                          uint32_t n) {
+
+  int16_t cos[TRIG_BLOCK];
+  int16_t sin[TRIG_BLOCK];
+  trig_components_t trig;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    trig = lw_math_trig_functions(theta[i]);
+    cos[i] = trig.cos;
+    sin[i] = trig.sin;
+  }
+  lw_math_park_trig_soa(alpha, beta, cos, sin, q, d, n);
+}
+
+/**
+ * @brief  lw_math_rev_park_trig_soa fed with the cosines and sines of theta
+ */
+static void rev_park_trig_soa(const int16_t *q, const int16_t *d,
+                              const int16_t *theta, int16_t *alpha,
+                              int16_t *beta, uint32_t n) {
+
+  int16_t cos[TRIG_BLOCK];
+  int16_t sin[TRIG_BLOCK];
+  trig_components_t trig;
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    trig = lw_math_trig_functions(theta[i]);
+    cos[i] = trig.cos;
+    sin[i] = trig.sin;
+  }
+  lw_math_rev_park_trig_soa(q, d, cos, sin, alpha, beta, n);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
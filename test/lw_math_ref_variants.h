@@ -0,0 +1,66 @@
+/*****************************************************************************
+ * Filename              :   lw_math_ref_variants.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_math_ref_variants.h
+ *  @brief This module declares the header-only and constexpr builds of the
+ *         lw_math functions under names that can be linked next to the
+ *         library, for the differential test driver
+ */
+
+#ifndef LW_MATH_REF_VARIANTS_H_
+#define LW_MATH_REF_VARIANTS_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+#include "lw_math.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+/* LW_MATH_HEADER_ONLY build, lw_math_ref_header_only.c */
+trig_components_t lw_math_ho_trig_functions(int16_t angle);
+int32_t lw_math_ho_sqrt(int32_t input);
+int16_t lw_math_ho_atan2(int16_t y, int16_t x);
+alphabeta_t lw_math_ho_clarke(ab_t input);
+qd_t lw_math_ho_park(alphabeta_t input, int16_t theta);
+alphabeta_t lw_math_ho_rev_park(qd_t input, int16_t theta);
+void lw_math_ho_park_multi(alphabeta_t input, int16_t theta,
+                           const int8_t *orders, qd_t *output,
+                           uint8_t n_frames);
+void lw_math_ho_clarke_soa(const int16_t *a, const int16_t *b, int16_t *alpha,
+                           int16_t *beta, uint32_t n);
+void lw_math_ho_park_soa(const int16_t *alpha, const int16_t *beta,
+                         const int16_t *theta, int16_t *q, int16_t *d,
+                         uint32_t n);
+void lw_math_ho_rev_park_soa(const int16_t *q, const int16_t *d,
+                             const int16_t *theta, int16_t *alpha,
+                             int16_t *beta, uint32_t n);
+
+/* constexpr build of lw_math.hpp, lw_math_ref_constexpr.cpp */
+trig_components_t lw_math_cx_trig_functions(int16_t angle);
+int32_t lw_math_cx_sqrt(int32_t input);
+int16_t lw_math_cx_atan2(int16_t y, int16_t x);
+alphabeta_t lw_math_cx_clarke(ab_t input);
+qd_t lw_math_cx_park(alphabeta_t input, int16_t theta);
+alphabeta_t lw_math_cx_rev_park(qd_t input, int16_t theta);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif /*LW_MATH_REF_VARIANTS_H_*/
+
+/*** End of File *************************************************************/
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Filename              :   lw_pi_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_pi_test.c
+ *  @brief Test driver of the PI controllers in saturation: the integrator
+ *         bounds of both anti-windup strategies with the widest gain
+ *         formats, the recovery when the error reverses, and the bank
+ *
+ *  usage: lw_pi_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_pi.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define N_SATURATED     (100000u)     /* steps held in saturation */
+#define OUT_MIN         (-20000)
+#define OUT_MAX         (25000)
+#define N_BANK          (4u)
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void test_scalar(const char *name, int16_t kp, uint8_t kp_shift, int16_t ki,
+                        uint8_t ki_shift, int back_calc, int16_t kb, uint32_t recovery);
+static void test_bank(void);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  /* widest formats: a proportional term of 2^30 against a q.30 integrator */
+  test_scalar("clamp", 32767, 0u, 32767, 30u, 0, 0, 1u);
+  test_scalar("back-calc kb=1.0", 32767, 0u, 32767, 30u, 1, 32767, 1u);
+  test_scalar("back-calc kb=0", 32767, 0u, 32767, 30u, 1, 0, 0u);
+  test_scalar("clamp slow", 16384, 14u, 1000, 16u, 0, 0, 1u);
+  /* kb = 0.01 balances ki * e only at the widened bound, which bleeds off
+   * at about 150 output units per step */
+  test_scalar("back-calc kb=0.01", 16384, 14u, 1000, 16u, 1, 328, 400u);
+  test_bank();
+
+  return (lw_test_result("lw_pi"));
+}
+
+/**
+ * @brief  Holds a controller in saturation with full scale errors of both
+ *         signs, checks the integrator bound and the output, then reverses
+ *         the error and counts the steps to leave the limit
+ * @param  name: description
+ * @param  kp: proportional gain
+ * @param  kp_shift: fractional bits of kp
+ * @param  ki: integral gain
+ * @param  ki_shift: fractional bits of ki
+ * @param  back_calc: nonzero for back-calculation anti-windup
+ * @param  kb: back-calculation gain
+ * @param  recovery: steps accepted to leave the limit, 0 if not checked
+ */
+static void test_scalar(const char *name, int16_t kp, uint8_t kp_shift, int16_t ki,
+                        uint8_t ki_shift, int back_calc, int16_t kb, uint32_t recovery) {
+
+  pi_t pi;
+  int32_t span = OUT_MAX - OUT_MIN;
+  int32_t wide = back_calc ? span : 0;
+  int64_t lo = (int64_t)(OUT_MIN - wide) * ((int64_t)1 << ki_shift);
+  int64_t hi = (int64_t)(OUT_MAX + wide) * ((int64_t)1 << ki_shift);
+  int64_t peak = 0;
+  uint32_t i;
+  uint32_t steps;
+  int16_t out = 0;
+  int in_bound = 1;
+  int at_limit = 1;
+
+  lw_pi_init(&pi, kp, kp_shift, ki, ki_shift, OUT_MIN, OUT_MAX);
+  if (back_calc) {
+    lw_pi_set_back_calc(&pi, kb);
+  }
+
+  for (i = 0u; i < N_SATURATED; i++) {
+    out = lw_pi_step(&pi, INT16_MAX);
+    in_bound = in_bound && (pi.integral >= lo) && (pi.integral <= hi);
+    peak = (pi.integral > peak) ? pi.integral : peak;
+  }
+  at_limit = (OUT_MAX == out);
+  for (i = 0u; i < N_SATURATED; i++) {
+    out = lw_pi_step(&pi, INT16_MIN);
+    in_bound = in_bound && (pi.integral >= lo) && (pi.integral <= hi);
+  }
+  at_limit = at_limit && (OUT_MIN == out);
+
+  lw_test_check(in_bound && at_limit,
+                "pi %-18s integrator within [%lld, %lld] * 2^-%u, peak %lld, output held",
+                name, (long long)(lo >> ki_shift), (long long)(hi >> ki_shift),
+                ki_shift, (long long)(peak >> ki_shift));
+
+  /* a positive error: the proportional term alone leaves the lower
+   * limit, the integrator must not hold the output there */
+  steps = 0u;
+  do {
+    out = lw_pi_step(&pi, 1000);
+    steps++;
+  } while ((OUT_MIN == out) && (steps < N_SATURATED));
+
+  if (recovery > 0u) {
+    lw_test_check(steps <= recovery, "pi %-18s leaves the lower limit after %u steps",
+                  name, steps);
+  }
+}
+
+/**
+ * @brief  Holds a bank in saturation with q.30 integrators and checks that
+ *         they stay within the output limits
+ */
+static void test_bank(void) {
+
+  int16_t kp[N_BANK] = {32767, 32767, 16384, 100};
+  int16_t ki[N_BANK] = {32767, 1, 1000, 32767};
+  int16_t out_min[N_BANK] = {OUT_MIN, -32768, -100, 0};
+  int16_t out_max[N_BANK] = {OUT_MAX, 32767, 100, 1};
+  int64_t integral[N_BANK];
+  int16_t error[N_BANK];
+  int16_t output[N_BANK];
+  int64_t lo;
+  int64_t hi;
+  pi_bank_t bank;
+  uint32_t i;
+  uint32_t k;
+  uint32_t sign;
+  int ok = 1;
+
+  bank.kp = kp;
+  bank.ki = ki;
+  bank.out_min = out_min;
+  bank.out_max = out_max;
+  bank.integral = integral;
+  bank.kp_shift = 0u;
+  bank.ki_shift = 30u;
+  bank.n = N_BANK;
+  lw_pi_bank_reset(&bank);
+
+  for (sign = 0u; sign < 2u; sign++) {
+    for (i = 0u; i < N_SATURATED; i++) {
+      for (k = 0u; k < N_BANK; k++) {
+        error[k] = (0u == sign) ? INT16_MAX : INT16_MIN;
+      }
+      lw_pi_bank_step(&bank, error, output);
+      for (k = 0u; k < N_BANK; k++) {
+        lo = (int64_t)out_min[k] * ((int64_t)1 << 30);
+        hi = (int64_t)out_max[k] * ((int64_t)1 << 30);
+        ok = ok && (integral[k] >= lo) && (integral[k] <= hi);
+      }
+    }
+    for (k = 0u; k < N_BANK; k++) {
+      ok = ok && (output[k] == ((0u == sign) ? out_max[k] : out_min[k]));
+    }
+  }
+
+  lw_test_check(ok, "pi bank integrators within the output limits, outputs held");
+}
+
+/*************** END OF FUNCTIONS ********************************************/
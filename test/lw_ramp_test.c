@@ -0,0 +1,273 @@
+/******************************************************************************
+ * Filename              :   lw_ramp_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_ramp_test.c
+ *  @brief Test driver of the ramp bank: traces of lw_ramp_bank_step checked
+ *         for overshoot, speed and speed change limits and exact landing,
+ *         on linear and acceleration-limited axes, with a target reversal,
+ *         a target moved inside the braking distance and random targets
+ *
+ *  usage: lw_ramp_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "lw_ramp.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define FS              (10000.0)
+#define N_AXES          (6u)
+#define N_STEPS         (40000u)
+#define REVERSAL_STEP   (3000u)
+#define N_RANDOM_STEPS  (200000u)
+#define HOLD_STEPS      (700u)        /* steps between random targets */
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Axis under test type definition
+ */
+typedef struct {
+  double slope;         /**< largest speed in FS/s */
+  double slope_acc;     /**< largest acceleration in FS/s^2, 0 = linear */
+  int16_t start;        /**< initial output */
+  int16_t target;       /**< target */
+  int16_t reversal;     /**< target from REVERSAL_STEP on */
+  const char *name;     /**< description */
+} axis_t;
+
+/**
+ * @brief  Trace checks of one axis type definition
+ */
+typedef struct {
+  int32_t prev_value;   /**< previous value */
+  int32_t prev_delta;   /**< previous change of the value */
+  int32_t max_delta;    /**< largest change of the value */
+  int32_t max_jump;     /**< largest change of the change of the value */
+  int32_t overshoot;    /**< largest excursion beyond the target */
+  uint32_t landed;      /**< number of steps up to the last move */
+} trace_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const axis_t axis_list[N_AXES] = {
+  {1.0, 0.0, 0, 30000, 30000, "linear 1 FS/s to 30000"},
+  {1.0, 10.0, 0, 19988, 19988, "1 FS/s, 10 FS/s^2 to 0.61 FS"},
+  {2.0, 50.0, 20000, -25000, -25000, "2 FS/s, 50 FS/s^2 down to -25000"},
+  {0.5, 1000.0, 0, 7, 7, "0.5 FS/s, 1000 FS/s^2 by 7 LSB"},
+  {1.0, 10.0, 0, 20000, -10000, "1 FS/s, 10 FS/s^2 reversed to -10000"},
+  {3.0, 0.0, 10000, -10000, 15000, "linear 3 FS/s reversed to 15000"},
+};
+
+static int32_t rate[N_AXES];
+static int32_t accel[N_AXES];
+static int32_t value[N_AXES];
+static int32_t speed[N_AXES];
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void test_inside_braking(void);
+static void test_random(void);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  ramp_bank_t bank;
+  trace_t trace[N_AXES];
+  int16_t start[N_AXES];
+  int16_t target[N_AXES];
+  int16_t output[N_AXES];
+  uint32_t i;
+  uint32_t k;
+  int32_t delta;
+  int32_t jump;
+  int32_t beyond;
+  int32_t goal;
+
+  lw_ramp_bank_init(&bank, rate, accel, value, speed, N_AXES);
+  for (i = 0u; i < N_AXES; i++) {
+    lw_ramp_bank_set(&bank, i, lw_ramp_rate(axis_list[i].slope, FS),
+                     (axis_list[i].slope_acc > 0.0) ?
+                     lw_ramp_rate(axis_list[i].slope_acc, FS * FS) : 0);
+    start[i] = axis_list[i].start;
+  }
+  lw_ramp_bank_reset(&bank, start);
+
+  for (i = 0u; i < N_AXES; i++) {
+    trace[i].prev_value = value[i];
+    trace[i].prev_delta = 0;
+    trace[i].max_delta = 0;
+    trace[i].max_jump = 0;
+    trace[i].overshoot = 0;
+    trace[i].landed = 0u;
+  }
+
+  for (k = 0u; k < N_STEPS; k++) {
+    for (i = 0u; i < N_AXES; i++) {
+      target[i] = (k < REVERSAL_STEP) ? axis_list[i].target : axis_list[i].reversal;
+    }
+    lw_ramp_bank_step(&bank, target, output);
+
+    for (i = 0u; i < N_AXES; i++) {
+      delta = value[i] - trace[i].prev_value;
+      jump = delta - trace[i].prev_delta;
+      trace[i].max_delta = (abs(delta) > trace[i].max_delta) ? abs(delta) : trace[i].max_delta;
+      trace[i].max_jump = (abs(jump) > trace[i].max_jump) ? abs(jump) : trace[i].max_jump;
+      trace[i].prev_value = value[i];
+      trace[i].prev_delta = delta;
+
+      /* beyond the final target, on the far side from the start */
+      goal = (int32_t)axis_list[i].reversal * 32768;
+      beyond = (goal >= ((int32_t)axis_list[i].start * 32768)) ?
+               (value[i] - goal) : (goal - value[i]);
+      trace[i].overshoot = (beyond > trace[i].overshoot) ? beyond : trace[i].overshoot;
+
+      trace[i].landed = (0 != delta) ? (k + 1u) : trace[i].landed;
+    }
+  }
+
+  for (i = 0u; i < N_AXES; i++) {
+    lw_test_check((0 == trace[i].overshoot) && (trace[i].max_delta <= rate[i]),
+                  "ramp %-38s no overshoot, speed %d <= %d", axis_list[i].name,
+                  trace[i].max_delta, rate[i]);
+    if (0 != accel[i]) {
+      lw_test_check(trace[i].max_jump <= accel[i], "ramp %-38s speed change %d <= %d",
+                    axis_list[i].name, trace[i].max_jump, accel[i]);
+    }
+    lw_test_check((value[i] == ((int32_t)axis_list[i].reversal * 32768)) &&
+                  (0 == speed[i]) && (output[i] == axis_list[i].reversal),
+                  "ramp %-38s lands exactly on %d after %u steps", axis_list[i].name,
+                  axis_list[i].reversal, trace[i].landed);
+  }
+
+  /* accel = 0: every step but the last one moves by exactly rate */
+  lw_test_check((((30000 * 32768) / rate[0]) + 1) == (int32_t)trace[0].landed,
+                "ramp linear axis lands after %u steps", trace[0].landed);
+
+  test_inside_braking();
+  test_random();
+
+  return (lw_test_result("lw_ramp"));
+}
+
+/**
+ * @brief  Moves the target 1 LSB ahead of an axis at full speed: the axis
+ *         must pass it, brake at accel and come back to it
+ */
+static void test_inside_braking(void) {
+
+  ramp_bank_t bank;
+  int16_t target;
+  int16_t output;
+  int16_t goal;
+  uint32_t k;
+  int32_t prev_value;
+  int32_t prev_delta;
+  int32_t delta;
+  int32_t jump;
+  int32_t max_jump = 0;
+  int32_t max_speed;
+
+  lw_ramp_bank_init(&bank, rate, accel, value, speed, 1u);
+  lw_ramp_bank_set(&bank, 0u, lw_ramp_rate(1.0, FS), lw_ramp_rate(10.0, FS * FS));
+
+  target = 30000;
+  for (k = 0u; k < 2000u; k++) {
+    lw_ramp_bank_step(&bank, &target, &output);
+  }
+  max_speed = speed[0];
+  prev_value = value[0];
+  prev_delta = speed[0];
+
+  goal = (int16_t)(output + 1);
+  for (k = 0u; k < N_STEPS; k++) {
+    lw_ramp_bank_step(&bank, &goal, &output);
+    delta = value[0] - prev_value;
+    jump = abs(delta - prev_delta);
+    max_jump = (jump > max_jump) ? jump : max_jump;
+    prev_value = value[0];
+    prev_delta = delta;
+  }
+
+  lw_test_check((max_speed == rate[0]) && (max_jump <= accel[0]),
+                "ramp target inside the braking distance, speed change %d <= %d",
+                max_jump, accel[0]);
+  lw_test_check((value[0] == ((int32_t)goal * 32768)) && (0 == speed[0]),
+                "ramp target inside the braking distance reached again");
+}
+
+/**
+ * @brief  Four acceleration-limited axes with random targets held for
+ *         HOLD_STEPS, too short to always arrive, then fixed targets
+ */
+static void test_random(void) {
+
+  static const double slope[4] = {1.0, 2.0, 0.5, 3.0};
+  static const double slope_acc[4] = {10.0, 50.0, 1000.0, 5.0};
+  ramp_bank_t bank;
+  int16_t target[4];
+  int16_t output[4];
+  int32_t prev_value[4];
+  int32_t prev_delta[4] = {0, 0, 0, 0};
+  uint32_t seed = 3u;
+  uint32_t i;
+  uint32_t k;
+  int32_t delta;
+  int32_t jump;
+  int ok_accel = 1;
+  int ok_land = 1;
+
+  lw_ramp_bank_init(&bank, rate, accel, value, speed, 4u);
+  for (i = 0u; i < 4u; i++) {
+    lw_ramp_bank_set(&bank, i, lw_ramp_rate(slope[i], FS),
+                     lw_ramp_rate(slope_acc[i], FS * FS));
+    prev_value[i] = value[i];
+  }
+
+  for (k = 0u; k < (N_RANDOM_STEPS + N_STEPS); k++) {
+    for (i = 0u; i < 4u; i++) {
+      if ((0u == (k % HOLD_STEPS)) && (k < N_RANDOM_STEPS)) {
+        seed = (seed * 1103515245u) + 12345u;
+        target[i] = (int16_t)((int32_t)(seed >> 16) - 32768);
+      }
+    }
+    lw_ramp_bank_step(&bank, target, output);
+    for (i = 0u; i < 4u; i++) {
+      delta = value[i] - prev_value[i];
+      jump = abs(delta - prev_delta[i]);
+      ok_accel = ok_accel && (jump <= accel[i]) && (abs(delta) <= rate[i]);
+      prev_value[i] = value[i];
+      prev_delta[i] = delta;
+    }
+  }
+
+  for (i = 0u; i < 4u; i++) {
+    ok_land = ok_land && (value[i] == ((int32_t)target[i] * 32768)) && (0 == speed[i]);
+  }
+
+  lw_test_check(ok_accel, "ramp random targets, change per step within rate, its change "
+                "within accel");
+  lw_test_check(ok_land, "ramp random targets, last targets reached exactly");
+}
+
+/*************** END OF FUNCTIONS ********************************************/
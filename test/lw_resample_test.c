@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Filename              :   lw_resample_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_resample_test.c
+ *  @brief Test driver of the polyphase sample-rate converter: one pass
+ *         against 13-sample blocks of the same stream, and the 50 Hz
+ *         amplitude and 1730 Hz alias through 20:1 decimation and 1:20
+ *         interpolation of a 20 kHz signal
+ *
+ *  usage: lw_resample_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include <string.h>
+#include "lw_resample.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define TWO_PI          (6.283185307179586)
+#define FS_HIGH         (20000.0)
+#define FS_LOW          (1000.0)
+#define N_INPUT         (20000u)      /* one second at 20 kHz */
+#define N_LOW           (1000u)       /* one second at 1 kHz */
+#define BLOCK           (13u)
+#define MAX_UP          (20u)
+#define MAX_TAPS        (160u)
+#define MAX_OUT         (RESAMPLE_OUT_SIZE(N_INPUT, 3u, 2u))
+
+/* test tones: the 1730 Hz one aliases to 270 Hz at 1 kHz */
+#define A_50            (20000.0)
+#define A_1730          (8000.0)
+
+/* largest accepted relative error of the 50 Hz amplitude and largest
+ * accepted 270 Hz alias in LSB */
+#define TOL_AMP         (1e-3)
+#define TOL_ALIAS       (2.0)
+
+/*****************************************************************************
+ * Module Typedefs
+ ******************************************************************************/
+
+/**
+ * @brief  Ratio under test type definition
+ */
+typedef struct {
+  uint16_t up;          /**< interpolation factor */
+  uint16_t down;        /**< decimation factor */
+  uint16_t n_taps;      /**< taps per phase */
+} ratio_t;
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const ratio_t ratio_list[] = {{3u, 2u, 16u}, {2u, 3u, 24u}, {1u, 20u, 160u},
+                                     {20u, 1u, 8u}};
+
+static int16_t coef[MAX_UP * MAX_TAPS];
+static int16_t delay[2u * MAX_TAPS];
+static int16_t input[N_INPUT];
+static int16_t single[MAX_OUT];
+static int16_t blocked[MAX_OUT];
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void make_input(uint32_t n, double fs, double a_1730);
+static uint32_t run(const ratio_t *ratio, uint32_t n, uint32_t block, int16_t *output);
+static double amplitude(const int16_t *output, uint32_t first, uint32_t n, double f,
+                        double fs);
+static void test_blocks(const ratio_t *ratio);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  const ratio_t *decim = &ratio_list[2];
+  const ratio_t *interp = &ratio_list[3];
+  uint32_t k;
+  uint32_t n_out;
+  double a50;
+  double alias;
+
+  for (k = 0u; k < (sizeof(ratio_list) / sizeof(ratio_list[0])); k++) {
+    test_blocks(&ratio_list[k]);
+  }
+
+  /* 20 kHz -> 1 kHz: the first 160 outputs cover the filter transient */
+  make_input(N_INPUT, FS_HIGH, A_1730);
+  n_out = run(decim, N_INPUT, BLOCK, single);
+  a50 = amplitude(single, 200u, 800u, 50.0, FS_LOW);
+  alias = amplitude(single, 200u, 800u, 270.0, FS_LOW);
+  lw_test_check(fabs((a50 / A_50) - 1.0) <= TOL_AMP,
+                "resample 20:1 50 Hz amplitude %.1f (expected %.0f)", a50, A_50);
+  lw_test_check((N_LOW == n_out) && (alias <= TOL_ALIAS),
+                "resample 20:1 1730 Hz alias at 270 Hz %.2f LSB, %u outputs", alias, n_out);
+
+  /* 1 kHz -> 20 kHz: 50 Hz alone, 1730 Hz is above the input Nyquist */
+  make_input(N_LOW, FS_LOW, 0.0);
+  n_out = run(interp, N_LOW, BLOCK, single);
+  a50 = amplitude(single, 4000u, 16000u, 50.0, FS_HIGH);
+  lw_test_check((N_INPUT == n_out) && (fabs((a50 / A_50) - 1.0) <= TOL_AMP),
+                "resample 1:20 50 Hz amplitude %.1f (expected %.0f), %u outputs", a50,
+                A_50, n_out);
+
+  return (lw_test_result("lw_resample"));
+}
+
+/**
+ * @brief  Fills input with 50 Hz and 1730 Hz tones
+ * @param  n: number of samples
+ * @param  fs: sampling frequency in Hz
+ * @param  a_1730: amplitude of the 1730 Hz tone
+ */
+static void make_input(uint32_t n, double fs, double a_1730) {
+
+  uint32_t i;
+
+  for (i = 0u; i < n; i++) {
+    input[i] = (int16_t)lrint((A_50 * sin(TWO_PI * 50.0 * (double)i / fs)) +
+                              (a_1730 * sin(TWO_PI * 1730.0 * (double)i / fs)));
+  }
+}
+
+/**
+ * @brief  Designs a converter and runs it over the input in blocks
+ * @param  ratio: ratio under test
+ * @param  n: number of input samples
+ * @param  block: samples per call
+ * @param  output: array of RESAMPLE_OUT_SIZE(n, up, down) outputs
+ * @retval number of outputs
+ */
+static uint32_t run(const ratio_t *ratio, uint32_t n, uint32_t block, int16_t *output) {
+
+  resample_t rs;
+  uint32_t done;
+  uint32_t len;
+  uint32_t n_out = 0u;
+
+  lw_resample_design(coef, ratio->up, ratio->down, ratio->n_taps);
+  lw_resample_init(&rs, coef, delay, ratio->up, ratio->down, ratio->n_taps);
+
+  for (done = 0u; done < n; done += len) {
+    len = ((n - done) < block) ? (n - done) : block;
+    n_out += lw_resample_process(&rs, &input[done], &output[n_out], len);
+  }
+
+  return (n_out);
+}
+
+/**
+ * @brief  Returns the amplitude of one frequency in an output, over a
+ *         whole number of its periods
+ * @param  output: output samples
+ * @param  first: first sample used
+ * @param  n: number of samples used
+ * @param  f: frequency in Hz
+ * @param  fs: sampling frequency of the output in Hz
+ * @retval peak amplitude
+ */
+static double amplitude(const int16_t *output, uint32_t first, uint32_t n, double f,
+                        double fs) {
+
+  uint32_t i;
+  double re = 0.0;
+  double im = 0.0;
+
+  for (i = 0u; i < n; i++) {
+    re += output[first + i] * cos(TWO_PI * f * (double)i / fs);
+    im += output[first + i] * sin(TWO_PI * f * (double)i / fs);
+  }
+
+  return (2.0 * hypot(re, im) / (double)n);
+}
+
+/**
+ * @brief  Checks that a stream cut in 13-sample blocks gives the same
+ *         output as a single pass
+ * @param  ratio: ratio under test
+ */
+static void test_blocks(const ratio_t *ratio) {
+
+  uint32_t n = (ratio->up > ratio->down) ? N_LOW : N_INPUT;
+  uint32_t n_single;
+  uint32_t n_blocked;
+
+  make_input(n, (ratio->up > ratio->down) ? FS_LOW : FS_HIGH, 0.0);
+
+  n_single = run(ratio, n, n, single);
+  n_blocked = run(ratio, n, BLOCK, blocked);
+
+  lw_test_check((n_single == n_blocked) &&
+                (0 == memcmp(single, blocked, n_single * sizeof(int16_t))),
+                "resample %u:%u %u outputs in %u-sample blocks bit-identical to one pass",
+                ratio->down, ratio->up, n_blocked, BLOCK);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
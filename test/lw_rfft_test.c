@@ -0,0 +1,249 @@
+/******************************************************************************
+ * Filename              :   lw_rfft_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_rfft_test.c
+ *  @brief Test driver of the real FFT helpers: bins 0, k and N/2 and the
+ *         whole half spectrum of lw_rfft_q15 against a double real DFT, at
+ *         amplitudes that take the split step through its scalings, the
+ *         block exponent, the power spectrum and the window tables against
+ *         the analytic windows
+ *
+ *  usage: lw_rfft_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include "lw_rfft.h"
+#include "lw_dft_ref.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define MAX_LOG2N       (12u)
+#define MAX_N           ((uint32_t)1 << MAX_LOG2N)
+#define TONE_BIN        (5u)
+
+/* split step scaling of lw_rfft_q15 from the largest component of the half
+ * size FFT: 32767 / (1 + sqrt(2)) and twice that */
+#define SPLIT_LIMIT_1   (13573)
+#define SPLIT_LIMIT_2   (27146)
+
+/* largest accepted error of a bin, relative to the largest bin */
+#define TOL_BIN         (2e-3)
+
+/* smallest accepted SNR in dB of the half spectrum */
+#define MIN_SNR         (45.0)
+
+/* largest accepted relative error of the tone power */
+#define TOL_POWER       (1e-2)
+
+/* largest accepted window error in LSB */
+#define TOL_WINDOW      (2.0)
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static const uint8_t log2n_list[] = {2u, 3u, 8u, MAX_LOG2N};
+
+/* peak amplitudes of the test signal, with split step scalings of 1 and 2 */
+static const double amplitude_list[] = {0.01, 0.2, 0.5, 0.99};
+
+static const uint32_t window_list[] = {64u, 1000u, MAX_N};
+
+/* split step scalings seen, bit s for a shift of s */
+static uint32_t split_seen = 0u;
+
+static int16_t input[MAX_N];
+static complex_q15_t half[MAX_N / 2u];
+static int16_t window[MAX_N];
+static complex_q15_t spectrum[(MAX_N / 2u) + 1u];
+static uint32_t power[(MAX_N / 2u) + 1u];
+static double ref_re[MAX_N];
+static double ref_im[MAX_N];
+static double out_re[MAX_N];
+static double out_im[MAX_N];
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static void test_rfft(uint8_t log2n, double amplitude);
+static void test_window(uint32_t n, rfft_window_t type);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  uint32_t k;
+  uint32_t a;
+  complex_q15_t corner;
+  uint32_t corner_power;
+  int16_t exponent;
+
+  for (k = 0u; k < (sizeof(log2n_list) / sizeof(log2n_list[0])); k++) {
+    for (a = 0u; a < (sizeof(amplitude_list) / sizeof(amplitude_list[0])); a++) {
+      test_rfft(log2n_list[k], amplitude_list[a]);
+    }
+  }
+
+  /* the last FFT stage has a unit twiddle, so the half size FFT never
+   * exceeds 23170 and the split step scaling of 3 is never needed */
+  lw_test_check(0x06u == split_seen, "rfft split step scalings 1 and 2 covered");
+
+  /* the largest power of a bin still fits an uint32_t */
+  corner.re = INT16_MIN;
+  corner.im = INT16_MIN;
+  lw_rfft_power_q15(&corner, &corner_power, 1u);
+  lw_test_check(2147483648u == corner_power, "rfft power of (-32768, -32768) is %u",
+                corner_power);
+
+  lw_test_check(EINVAL == lw_rfft_q15(input, spectrum, 1u, &exponent),
+                "rfft log2n 1 returns EINVAL");
+  lw_test_check(EINVAL == lw_rfft_q15(input, spectrum, LW_FFT_MAX_LOG2N + 2u, &exponent),
+                "rfft log2n %u returns EINVAL", LW_FFT_MAX_LOG2N + 2u);
+
+  for (k = 0u; k < (sizeof(window_list) / sizeof(window_list[0])); k++) {
+    test_window(window_list[k], RFFT_WINDOW_HANN);
+    test_window(window_list[k], RFFT_WINDOW_BLACKMAN);
+  }
+
+  return (lw_test_result("lw_rfft"));
+}
+
+/**
+ * @brief  Runs lw_rfft_q15 on DC, a tone on TONE_BIN (or bin 1 for the
+ *         smallest sizes) and a fs/2 component, and checks it against the
+ *         double real DFT
+ * @param  log2n: base 2 logarithm of the size
+ * @param  amplitude: peak amplitude of the signal as a fraction of full scale
+ */
+static void test_rfft(uint8_t log2n, double amplitude) {
+
+  uint32_t n = (uint32_t)1 << log2n;
+  uint32_t m = n / 2u;
+  uint32_t tone = (m > TONE_BIN) ? TONE_BIN : 1u;
+  uint32_t bins[3];
+  uint32_t i;
+  uint32_t b;
+  uint8_t shift;
+  int16_t exponent = 0;
+  int16_t fft_exp = 0;
+  int32_t max = 0;
+  int err;
+  int ok = 1;
+  double x;
+  double peak = 0.0;
+  double bin_err;
+  double worst = 0.0;
+  double snr;
+  double p_ref;
+  double p_fix;
+
+  bins[0] = 0u;
+  bins[1] = tone;
+  bins[2] = m;
+
+  for (i = 0u; i < n; i++) {
+    x = (0.25 * cos(LW_DFT_REF_TWO_PI * (double)(tone * i) / (double)n + 0.3)) +
+        0.125 + (((i & 1u) != 0u) ? -0.0625 : 0.0625);
+    input[i] = (int16_t)lrint(amplitude * x * 32767.0 / 0.4375);
+    ref_re[i] = input[i];
+    ref_im[i] = 0.0;
+  }
+
+  err = lw_rfft_q15(input, spectrum, log2n, &exponent);
+  lw_dft_ref(ref_re, ref_im, log2n, 0);
+
+  /* block exponent: the one of the packed half size FFT plus the split
+   * step scaling, less the factor 2 of the split formulas */
+  for (i = 0u; i < m; i++) {
+    half[i].re = input[2u * i];
+    half[i].im = input[(2u * i) + 1u];
+  }
+  (void)lw_fft_q15(half, (uint8_t)(log2n - 1u), FFT_FORWARD, FFT_ORDER_NATURAL, &fft_exp);
+  for (i = 0u; i < m; i++) {
+    max = (abs(half[i].re) > max) ? abs(half[i].re) : max;
+    max = (abs(half[i].im) > max) ? abs(half[i].im) : max;
+  }
+  shift = (uint8_t)((max <= SPLIT_LIMIT_1) ? 1u : ((max <= SPLIT_LIMIT_2) ? 2u : 3u));
+  split_seen |= 1u << shift;
+  lw_test_check((0 == err) && (exponent == (fft_exp + shift - 1)),
+                "rfft N=%-5u amplitude %.3f exponent %d = %d + split shift %u - 1",
+                n, amplitude, exponent, fft_exp, shift);
+
+  for (i = 0u; i <= m; i++) {
+    out_re[i] = ldexp((double)spectrum[i].re, exponent);
+    out_im[i] = ldexp((double)spectrum[i].im, exponent);
+    peak = (hypot(ref_re[i], ref_im[i]) > peak) ? hypot(ref_re[i], ref_im[i]) : peak;
+  }
+
+  for (b = 0u; b < 3u; b++) {
+    bin_err = hypot(out_re[bins[b]] - ref_re[bins[b]], out_im[bins[b]] - ref_im[bins[b]]);
+    worst = (bin_err > worst) ? bin_err : worst;
+  }
+  ok = (0 == err) && (worst <= (TOL_BIN * peak));
+  lw_test_check(ok, "rfft N=%-5u amplitude %.3f bins 0, %u, %u error %.2e of peak, exponent %d",
+                n, amplitude, tone, m, worst / peak, exponent);
+
+  snr = lw_dft_ref_snr(ref_re, ref_im, out_re, out_im, m + 1u);
+  lw_test_check(snr >= MIN_SNR, "rfft N=%-5u amplitude %.3f half spectrum SNR %.1f dB",
+                n, amplitude, snr);
+
+  /* power of the tone bin, in q2.30 units after the block exponent */
+  lw_rfft_power_q15(spectrum, power, m + 1u);
+  ok = 1;
+  for (i = 0u; i <= m; i++) {
+    ok = ok && (power[i] == (uint32_t)(((int32_t)spectrum[i].re * spectrum[i].re) +
+                                       ((int32_t)spectrum[i].im * spectrum[i].im)));
+  }
+  p_ref = (ref_re[tone] * ref_re[tone]) + (ref_im[tone] * ref_im[tone]);
+  p_fix = ldexp((double)power[tone], 2 * exponent);
+  lw_test_check(ok && (fabs(p_fix - p_ref) <= (TOL_POWER * p_ref)),
+                "rfft N=%-5u amplitude %.3f tone power error %.2e", n, amplitude,
+                fabs(p_fix - p_ref) / p_ref);
+}
+
+/**
+ * @brief  Checks a window table against the analytic periodic window
+ * @param  n: window length
+ * @param  type: window type
+ */
+static void test_window(uint32_t n, rfft_window_t type) {
+
+  uint32_t i;
+  double phase;
+  double w;
+  double max_err = 0.0;
+
+  lw_rfft_window_init(window, n, type);
+
+  for (i = 0u; i < n; i++) {
+    phase = LW_DFT_REF_TWO_PI * (double)i / (double)n;
+    if (RFFT_WINDOW_BLACKMAN == type) {
+      w = 0.42 - (0.5 * cos(phase)) + (0.08 * cos(2.0 * phase));
+    }
+    else {
+      w = 0.5 - (0.5 * cos(phase));
+    }
+    w = (w * 32768.0 > 32767.0) ? 32767.0 : (w * 32768.0);
+    max_err = (fabs((double)window[i] - w) > max_err) ? fabs((double)window[i] - w) : max_err;
+  }
+
+  lw_test_check(max_err <= TOL_WINDOW, "rfft window %-8s n=%-5u max error %.2f LSB",
+                (RFFT_WINDOW_BLACKMAN == type) ? "blackman" : "hann", n, max_err);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
@@ -0,0 +1,260 @@
+/******************************************************************************
+ * Filename              :   lw_svpwm_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_svpwm_test.c
+ *  @brief Test driver of the space vector modulator: the sector of a vector
+ *         turned by one degree steps, the line-to-line voltages of the 7 and
+ *         5-segment sequences, their centering and rail clamping, clipping
+ *         beyond the linear range, the bus voltage limits and the batch
+ *
+ *  usage: lw_svpwm_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <math.h>
+#include "lw_math.h"
+#include "lw_svpwm.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define TWO_PI          (6.283185307179586)
+#define PERIOD          (5000u)       /* timer period in counts */
+#define VBUS            (20000)       /* bus voltage, same unit as alpha-beta */
+#define N_ANGLES        (360u)
+#define N_BATCH         (7u)
+
+/* largest vector of the linear range, vbus / sqrt(3), with a margin */
+#define LINEAR          (0.95 * (double)VBUS / 1.7320508075688772)
+#define OVERMODULATED   (0.75 * (double)VBUS)
+
+/* largest accepted error of a line-to-line voltage in counts: two compare
+ * values truncated towards zero, up to 2 counts, and the phase voltages
+ * rebuilt with a q1.15 sqrt(3)/2 from a rounded Clarke output */
+#define TOL_LL          (3.0)
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static alphabeta_t make_vector(double magnitude, double theta, double *v);
+static void test_mode(svpwm_mode_t mode, const char *name);
+static void test_overmodulation(void);
+static void test_vbus(void);
+static void test_batch(void);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  test_mode(SVPWM_7_SEGMENT, "7-segment");
+  test_mode(SVPWM_5_SEGMENT, "5-segment");
+  test_overmodulation();
+  test_vbus();
+  test_batch();
+
+  return (lw_test_result("lw_svpwm"));
+}
+
+/**
+ * @brief  Builds the vector of a positive sequence at one angle through
+ *         lw_math_clarke, so that the sectors follow its convention: sector
+ *         k spans phase a angles from (k - 1) * 60 to k * 60 degrees
+ * @param  magnitude: amplitude of the phase voltages
+ * @param  theta: phase a angle in rad
+ * @param  v: array of 3 phase voltages, NULL if not needed
+ * @retval vector in alphabeta_t format
+ */
+static alphabeta_t make_vector(double magnitude, double theta, double *v) {
+
+  ab_t ab;
+  double va = magnitude * cos(theta);
+  double vb = magnitude * cos(theta - (TWO_PI / 3.0));
+
+  ab.a = (int16_t)lrint(va);
+  ab.b = (int16_t)lrint(vb);
+
+  if (NULL != v) {
+    v[0] = ab.a;
+    v[1] = ab.b;
+    v[2] = -v[0] - v[1];
+  }
+
+  return (lw_math_clarke(ab));
+}
+
+/**
+ * @brief  Turns a vector of the linear range by one degree steps, offset by
+ *         half a degree from the sector boundaries, and checks the sector,
+ *         the line-to-line voltages, the phase ordering in the sector and
+ *         the centering or rail clamping of the sequence
+ * @param  mode: modulation sequence
+ * @param  name: description
+ */
+static void test_mode(svpwm_mode_t mode, const char *name) {
+
+  svpwm_t svpwm;
+  svpwm_out_t out;
+  alphabeta_t input;
+  uint32_t k;
+  uint32_t sector;
+  uint16_t hi;
+  uint16_t lo;
+  double v[3];
+  double cmp[3];
+  double err;
+  double max_err = 0.0;
+  int ok_sector = 1;
+  int ok_order = 1;
+  int ok_seq = 1;
+
+  lw_svpwm_init(&svpwm, PERIOD, mode);
+  lw_svpwm_set_vbus(&svpwm, VBUS);
+
+  for (k = 0u; k < N_ANGLES; k++) {
+    input = make_vector(LINEAR, TWO_PI * ((double)k + 0.5) / (double)N_ANGLES, v);
+    out = lw_svpwm_run(&svpwm, input);
+    sector = (k / 60u) + 1u;
+    ok_sector = ok_sector && (sector == out.sector);
+
+    cmp[0] = out.cmp_a;
+    cmp[1] = out.cmp_b;
+    cmp[2] = out.cmp_c;
+    err = fabs((cmp[0] - cmp[1]) - ((v[0] - v[1]) * PERIOD / VBUS));
+    max_err = (err > max_err) ? err : max_err;
+    err = fabs((cmp[1] - cmp[2]) - ((v[1] - v[2]) * PERIOD / VBUS));
+    max_err = (err > max_err) ? err : max_err;
+
+    /* sectors 1 to 6: a > b > c, b > a > c, b > c > a, c > b > a, c > a > b,
+     * a > c > b */
+    switch (out.sector) {
+      case 1u: ok_order = ok_order && (cmp[0] >= cmp[1]) && (cmp[1] >= cmp[2]); break;
+      case 2u: ok_order = ok_order && (cmp[1] >= cmp[0]) && (cmp[0] >= cmp[2]); break;
+      case 3u: ok_order = ok_order && (cmp[1] >= cmp[2]) && (cmp[2] >= cmp[0]); break;
+      case 4u: ok_order = ok_order && (cmp[2] >= cmp[1]) && (cmp[1] >= cmp[0]); break;
+      case 5u: ok_order = ok_order && (cmp[2] >= cmp[0]) && (cmp[0] >= cmp[1]); break;
+      default: ok_order = ok_order && (cmp[0] >= cmp[2]) && (cmp[2] >= cmp[1]); break;
+    }
+
+    hi = (out.cmp_a > out.cmp_b) ? out.cmp_a : out.cmp_b;
+    hi = (out.cmp_c > hi) ? out.cmp_c : hi;
+    lo = (out.cmp_a < out.cmp_b) ? out.cmp_a : out.cmp_b;
+    lo = (out.cmp_c < lo) ? out.cmp_c : lo;
+    if (SVPWM_5_SEGMENT == mode) {
+      /* one phase on a rail, the others strictly inside the period */
+      ok_seq = ok_seq && ((0u == lo) != (PERIOD == hi));
+    }
+    else {
+      /* equal zero vectors on both ends */
+      ok_seq = ok_seq && (abs(((int32_t)hi + lo) - (int32_t)PERIOD) <= 1);
+    }
+  }
+
+  lw_test_check(ok_sector, "svpwm %s sector of %u angles", name, N_ANGLES);
+  lw_test_check(ok_order, "svpwm %s phase ordering within the sector", name);
+  lw_test_check(max_err <= TOL_LL, "svpwm %s line-to-line error %.2f counts", name,
+                max_err);
+  lw_test_check(ok_seq, "svpwm %s %s", name, (SVPWM_5_SEGMENT == mode) ?
+                "one phase clamped to a rail" : "sequence centered in the period");
+}
+
+/**
+ * @brief  Turns a vector beyond the linear range: the compare values must
+ *         stay within the period with the largest phase on its rail, and
+ *         the sector must not change
+ */
+static void test_overmodulation(void) {
+
+  svpwm_t svpwm;
+  svpwm_out_t out;
+  uint32_t k;
+  uint32_t mode;
+  uint16_t hi;
+  uint16_t lo;
+  int ok = 1;
+
+  for (mode = 0u; mode < 2u; mode++) {
+    lw_svpwm_init(&svpwm, PERIOD, (0u == mode) ? SVPWM_7_SEGMENT : SVPWM_5_SEGMENT);
+    lw_svpwm_set_vbus(&svpwm, VBUS);
+
+    for (k = 0u; k < N_ANGLES; k++) {
+      out = lw_svpwm_run(&svpwm, make_vector(OVERMODULATED,
+                                             TWO_PI * ((double)k + 0.5) / (double)N_ANGLES,
+                                             NULL));
+      hi = (out.cmp_a > out.cmp_b) ? out.cmp_a : out.cmp_b;
+      hi = (out.cmp_c > hi) ? out.cmp_c : hi;
+      lo = (out.cmp_a < out.cmp_b) ? out.cmp_a : out.cmp_b;
+      lo = (out.cmp_c < lo) ? out.cmp_c : lo;
+      ok = ok && (((k / 60u) + 1u) == out.sector) && (hi <= PERIOD) &&
+           ((0u == lo) || (PERIOD == hi));
+    }
+  }
+
+  lw_test_check(ok, "svpwm %.0f%% of the bus clipped within the period, sectors kept",
+                100.0 * OVERMODULATED / VBUS);
+}
+
+/**
+ * @brief  Checks the gain at the smallest bus voltage and the 50% duty
+ *         cycle without a bus
+ */
+static void test_vbus(void) {
+
+  svpwm_t svpwm;
+  svpwm_out_t out;
+
+  lw_svpwm_init(&svpwm, UINT16_MAX, SVPWM_7_SEGMENT);
+  lw_svpwm_set_vbus(&svpwm, 1);
+  lw_test_check(2147450880 == svpwm.gain, "svpwm period 65535 on a unit bus, gain %ld",
+                (long)svpwm.gain);
+
+  lw_svpwm_set_vbus(&svpwm, 0);
+  out = lw_svpwm_run(&svpwm, make_vector(1000.0, 1.0, NULL));
+  lw_test_check((0 == svpwm.gain) && (32767u == out.cmp_a) && (32767u == out.cmp_b) &&
+                (32767u == out.cmp_c), "svpwm no bus, all phases at 50%%");
+}
+
+/**
+ * @brief  Runs a batch of modulators with different periods, buses and
+ *         sequences against one call per modulator
+ */
+static void test_batch(void) {
+
+  svpwm_t svpwm[N_BATCH];
+  alphabeta_t input[N_BATCH];
+  svpwm_out_t output[N_BATCH];
+  svpwm_out_t out;
+  uint32_t i;
+  int ok = 1;
+
+  for (i = 0u; i < N_BATCH; i++) {
+    lw_svpwm_init(&svpwm[i], (uint16_t)(1000u + (i * 700u)),
+                  (0u == (i & 1u)) ? SVPWM_7_SEGMENT : SVPWM_5_SEGMENT);
+    lw_svpwm_set_vbus(&svpwm[i], (int16_t)(VBUS - (int16_t)(i * 1000u)));
+    input[i] = make_vector(LINEAR * 0.7, (double)i, NULL);
+  }
+
+  lw_svpwm_run_batch(svpwm, input, output, N_BATCH);
+
+  for (i = 0u; i < N_BATCH; i++) {
+    out = lw_svpwm_run(&svpwm[i], input[i]);
+    ok = ok && (out.cmp_a == output[i].cmp_a) && (out.cmp_b == output[i].cmp_b) &&
+         (out.cmp_c == output[i].cmp_c) && (out.sector == output[i].sector);
+  }
+
+  lw_test_check(ok, "svpwm batch of %u modulators matches one call each", N_BATCH);
+}
+
+/*************** END OF FUNCTIONS ********************************************/
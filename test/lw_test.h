@@ -0,0 +1,71 @@
+/*****************************************************************************
+ * Filename              :   lw_test.h
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_test.h
+ *  @brief This module defines the assertion helpers shared by the module
+ *         test drivers: every check prints one line and the failures are
+ *         counted for the exit status
+ */
+
+#ifndef LW_TEST_H_
+#define LW_TEST_H_
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+static uint32_t lw_test_n_failed = 0u;
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/**
+ * @brief  Prints the result of one check and counts it when it failed
+ * @param  ok: nonzero when the check passed
+ * @param  fmt: printf format of the check description
+ */
+static void lw_test_check(int ok, const char *fmt, ...) {
+
+  va_list args;
+
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+  printf(" %s\n", ok ? "ok" : "FAIL");
+
+  if (!ok) {
+    lw_test_n_failed++;
+  }
+}
+
+/**
+ * @brief  Prints the summary line of a test driver
+ * @param  name: test driver name
+ * @retval exit status of the test driver
+ */
+static int lw_test_result(const char *name) {
+
+  printf("%s %s: %u check(s) failed\n", (0u == lw_test_n_failed) ? "PASS" : "FAIL",
+         name, lw_test_n_failed);
+
+  return ((0u == lw_test_n_failed) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+#endif /*LW_TEST_H_*/
+
+/*** End of File *************************************************************/
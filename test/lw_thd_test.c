@@ -0,0 +1,337 @@
+/******************************************************************************
+ * Filename              :   lw_thd_test.c
+ * Author                :   Giulio Dalla Vecchia
+ * Origin Date           :   17 oct 2026
+ *
+ * Copyright (c) 2022 Giulio Dalla Vecchia. All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file lw_thd_test.c
+ *  @brief Test driver of the harmonic analyzer: windows synchronized on the
+ *         wraps of the angle in both directions of rotation, a three-phase
+ *         50 Hz +-2 Hz signal with 5th, 7th and 11th harmonics, and the
+ *         saturated paths (full scale square wave, sixteen equal orders),
+ *         and a first sample in the fourth quadrant that is not a wrap
+ *
+ *  usage: lw_thd_test
+ */
+
+/*****************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <errno.h>
+#include <math.h>
+#include "lw_thd.h"
+#include "lw_test.h"
+
+/*****************************************************************************
+ * Module Preprocessor Constants
+ ******************************************************************************/
+
+#define FS              (10000.0)
+#define TWO_PI          (6.283185307179586)
+#define N_SAMPLES       (10000u)      /* one second */
+#define BLOCK           (97u)         /* windows close inside the blocks */
+#define N_PHASES        (3u)
+#define N_CYCLES        (5u)
+
+/* harmonic amplitudes relative to the fundamental */
+#define H5              (0.08)
+#define H7              (0.05)
+#define H11             (0.03)
+
+/* largest accepted THD error, fundamental error and absent order reading */
+#define TOL_THD         (0.004)
+#define TOL_FUND        (0.01)
+#define TOL_ABSENT      (40)          /* 0.2% of the fundamental */
+
+/* the same over a window of one period, which leaks more of the drift; a
+ * window of part of a period reads a THD above 0.2 */
+#define TOL_THD_1       (0.02)
+#define TOL_ABSENT_1    (200)
+
+/*****************************************************************************
+ * Module Variable Definitions
+ ******************************************************************************/
+
+/* the 3rd order is absent from the signal */
+static const int8_t grid_orders[] = {1, 3, 5, 7, 11};
+
+static const int8_t square_orders[] = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21,
+                                       23, 25, 27, 29, 31};
+
+static const int8_t flat_orders[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+                                     13, 14, 15, 16};
+
+static thd_channel_t channels[N_PHASES];
+static int16_t input[N_SAMPLES * N_PHASES];
+static int16_t theta[N_SAMPLES];
+
+/*****************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+
+static uint32_t make_angles(double direction, double phase0, uint32_t *first_wrap);
+static void test_grid(double direction);
+static void test_square(void);
+static void test_flat(void);
+static void test_quadrant(double direction);
+
+/*****************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+int main(void) {
+
+  thd_t thd;
+  int8_t bad_orders[2];
+
+  test_grid(1.0);
+  test_grid(-1.0);
+  test_square();
+  test_flat();
+  test_quadrant(1.0);
+  test_quadrant(-1.0);
+
+  bad_orders[0] = 2;
+  bad_orders[1] = 1;
+  lw_test_check(EINVAL == lw_thd_init(&thd, bad_orders, 2u, 1u, channels, 1u),
+                "thd init with orders[0] != 1 returns EINVAL");
+
+  return (lw_test_result("lw_thd"));
+}
+
+/**
+ * @brief  Fills theta with the angle of a 50 Hz +-2 Hz fundamental
+ * @param  direction: 1 for a positive rotation, -1 for a negative one
+ * @param  phase0: angle of the first sample in rad
+ * @param  first_wrap: index of the first sample after the first wrap
+ * @retval number of wraps of the angle between the samples
+ */
+static uint32_t make_angles(double direction, double phase0, uint32_t *first_wrap) {
+
+  uint32_t i;
+  uint32_t wraps = 0u;
+  double phase = phase0;
+  double turn = floor(phase0 / TWO_PI);
+
+  *first_wrap = 0u;
+
+  for (i = 0u; i < N_SAMPLES; i++) {
+    if (floor(phase / TWO_PI) != turn) {
+      turn = floor(phase / TWO_PI);
+      *first_wrap = (0u == wraps) ? i : *first_wrap;
+      wraps++;
+    }
+    theta[i] = (int16_t)(uint16_t)((uint32_t)lrint((phase - (turn * TWO_PI)) / TWO_PI *
+                                                   65536.0) & 0xFFFFu);
+    phase += direction * TWO_PI * (50.0 + (2.0 * sin(TWO_PI * 0.5 * (double)i / FS))) / FS;
+  }
+
+  return (wraps);
+}
+
+/**
+ * @brief  Three phases with 5th, 7th and 11th harmonics on the angle of a
+ *         drifting fundamental, windows of N_CYCLES periods
+ * @param  direction: 1 for a positive rotation, -1 for a negative one
+ */
+static void test_grid(double direction) {
+
+  const char *name = (direction > 0.0) ? "positive" : "negative";
+  thd_t thd;
+  uint32_t wraps;
+  uint32_t first_wrap;
+  uint32_t windows = 0u;
+  uint32_t checked = 0u;
+  uint32_t i;
+  uint32_t c;
+  uint32_t n;
+  uint32_t done;
+  double th;
+  double shift;
+  double err;
+  double expected = sqrt((H5 * H5) + (H7 * H7) + (H11 * H11));
+  double a1 = 20000.0;
+  double worst_thd = 0.0;
+  double worst_fund = 0.0;
+  int worst_absent = 0;
+  int synced;
+
+  /* the first sample is at 120 degrees: the partial period before the
+   * first wrap must be left out */
+  wraps = make_angles(direction, TWO_PI / 3.0, &first_wrap);
+
+  for (i = 0u; i < N_SAMPLES; i++) {
+    th = (double)(uint16_t)theta[i] * TWO_PI / 65536.0;
+    for (c = 0u; c < N_PHASES; c++) {
+      shift = -TWO_PI * (double)c / 3.0;
+      input[(i * N_PHASES) + c] = (int16_t)lrint(a1 * (cos(th + shift) +
+                                                 (H5 * cos(5.0 * (th + shift))) +
+                                                 (H7 * cos(7.0 * (th + shift))) +
+                                                 (H11 * cos(11.0 * (th + shift)))));
+    }
+  }
+
+  (void)lw_thd_init(&thd, grid_orders, (uint8_t)sizeof(grid_orders), N_CYCLES,
+                    channels, N_PHASES);
+
+  /* nothing is summed before the first wrap */
+  (void)lw_thd_process(&thd, input, theta, first_wrap);
+  synced = (0u == thd.n_samples);
+
+  for (done = first_wrap; done < N_SAMPLES; done += n) {
+    n = ((N_SAMPLES - done) < BLOCK) ? (N_SAMPLES - done) : BLOCK;
+    windows += lw_thd_process(&thd, &input[done * N_PHASES], &theta[done], n);
+    if (windows > checked) {
+      checked = windows;
+      for (c = 0u; c < N_PHASES; c++) {
+        err = fabs((channels[c].thd / 32768.0) - expected);
+        worst_thd = (err > worst_thd) ? err : worst_thd;
+        err = fabs((channels[c].amplitude[0] / a1) - 1.0);
+        worst_fund = (err > worst_fund) ? err : worst_fund;
+        worst_absent = (channels[c].amplitude[1] > worst_absent) ?
+                       channels[c].amplitude[1] : worst_absent;
+      }
+    }
+  }
+
+  lw_test_check(synced && (windows == ((wraps - 1u) / N_CYCLES)),
+                "thd %s rotation %u windows after %u wraps, first window at a wrap",
+                name, windows, wraps);
+  lw_test_check(worst_thd <= TOL_THD, "thd %s rotation THD error %.4f (expected %.4f)",
+                name, worst_thd, expected);
+  lw_test_check(worst_fund <= TOL_FUND, "thd %s rotation fundamental error %.4f",
+                name, worst_fund);
+  lw_test_check(worst_absent <= TOL_ABSENT, "thd %s rotation absent 3rd order %d LSB",
+                name, worst_absent);
+}
+
+/**
+ * @brief  Full scale square wave 45 degrees off the angle: the fundamental
+ *         projections give a root of 41720, saturated to 32767
+ */
+static void test_square(void) {
+
+  thd_t thd;
+  uint32_t i;
+  uint32_t k;
+  uint32_t windows;
+  double th;
+  uint32_t first_wrap;
+  double sum_sq = 0.0;
+  double expected;
+
+  (void)make_angles(1.0, 0.0, &first_wrap);
+  for (i = 0u; i < N_SAMPLES; i++) {
+    th = (double)(uint16_t)theta[i] * TWO_PI / 65536.0;
+    input[i] = (cos(th + (TWO_PI / 8.0)) >= 0.0) ? INT16_MAX : -INT16_MAX;
+  }
+
+  (void)lw_thd_init(&thd, square_orders, (uint8_t)sizeof(square_orders), N_CYCLES,
+                    channels, 1u);
+  windows = lw_thd_process(&thd, input, theta, N_SAMPLES);
+
+  /* harmonics of 4/pi/k of full scale over a saturated fundamental */
+  for (k = 1u; k < sizeof(square_orders); k++) {
+    sum_sq += pow(4.0 / 3.141592653589793 * 32767.0 / (double)square_orders[k], 2.0);
+  }
+  expected = sqrt(sum_sq) / 32767.0;
+
+  lw_test_check((windows > 0u) && (INT16_MAX == channels[0].amplitude[0]),
+                "thd square wave fundamental saturated to %d", channels[0].amplitude[0]);
+  lw_test_check((windows > 0u) && (fabs((channels[0].thd / 32768.0) - expected) <= 0.01),
+                "thd square wave THD %.4f (expected %.4f)", channels[0].thd / 32768.0,
+                expected);
+}
+
+/**
+ * @brief  Sixteen equal orders of 2000: THD sqrt(15) saturates to 1.0
+ */
+static void test_flat(void) {
+
+  thd_t thd;
+  uint32_t i;
+  uint32_t k;
+  uint32_t windows;
+  double th;
+  uint32_t first_wrap;
+  double x;
+  int ok_amp = 1;
+
+  (void)make_angles(1.0, 0.0, &first_wrap);
+  for (i = 0u; i < N_SAMPLES; i++) {
+    th = (double)(uint16_t)theta[i] * TWO_PI / 65536.0;
+    x = 0.0;
+    for (k = 0u; k < sizeof(flat_orders); k++) {
+      x += 2000.0 * cos((double)flat_orders[k] * th);
+    }
+    input[i] = (int16_t)lrint(x);
+  }
+
+  (void)lw_thd_init(&thd, flat_orders, (uint8_t)sizeof(flat_orders), N_CYCLES,
+                    channels, 1u);
+  windows = lw_thd_process(&thd, input, theta, N_SAMPLES);
+
+  for (k = 0u; k < sizeof(flat_orders); k++) {
+    ok_amp = ok_amp && (abs(channels[0].amplitude[k] - 2000) <= 40);
+  }
+
+  lw_test_check((windows > 0u) && ok_amp, "thd sixteen orders read 2000 +-2%%");
+  lw_test_check((windows > 0u) && (INT16_MAX == channels[0].thd),
+                "thd sixteen orders THD saturated to %d", channels[0].thd);
+}
+
+/**
+ * @brief  Pure fundamental whose first sample is at 300 degrees, windows of
+ *         one period: the first sample must not count as a wrap, or the
+ *         first window closes after part of a period
+ * @param  direction: 1 for a positive rotation, -1 for a negative one
+ */
+static void test_quadrant(double direction) {
+
+  const char *name = (direction > 0.0) ? "positive" : "negative";
+  thd_t thd;
+  uint32_t i;
+  uint32_t wraps;
+  uint32_t first_wrap;
+  uint32_t windows = 0u;
+  double th;
+  int synced;
+  int first_ok = 0;
+
+  wraps = make_angles(direction, 5.0 * TWO_PI / 6.0, &first_wrap);
+  for (i = 0u; i < N_SAMPLES; i++) {
+    th = (double)(uint16_t)theta[i] * TWO_PI / 65536.0;
+    input[i] = (int16_t)lrint(16383.0 * cos(th));
+  }
+
+  (void)lw_thd_init(&thd, grid_orders, (uint8_t)sizeof(grid_orders), 1u, channels, 1u);
+
+  /* the samples before the first wrap are left out */
+  (void)lw_thd_process(&thd, input, theta, first_wrap);
+  synced = (0u == thd.n_samples);
+
+  /* one sample per call, to read the first window as it closes */
+  for (i = first_wrap; i < N_SAMPLES; i++) {
+    windows += lw_thd_process(&thd, &input[i], &theta[i], 1u);
+    if ((1u == windows) && (0 == first_ok)) {
+      first_ok = (abs(channels[0].amplitude[0] - 16383) <= (int)(16383.0 * TOL_FUND)) &&
+                 (channels[0].amplitude[2] <= TOL_ABSENT_1) &&
+                 ((channels[0].thd / 32768.0) <= TOL_THD_1);
+      first_ok = first_ok ? 1 : -1;
+      printf("thd %s rotation from 300 degrees first window amplitude %d, 5th %d, "
+             "THD %d\n", name, channels[0].amplitude[0], channels[0].amplitude[2],
+             channels[0].thd);
+    }
+  }
+
+  lw_test_check(synced && (windows == (wraps - 1u)),
+                "thd %s rotation from 300 degrees %u windows after %u wraps", name,
+                windows, wraps);
+  lw_test_check(1 == first_ok, "thd %s rotation from 300 degrees first window is a "
+                "whole period", name);
+}
+
+/*************** END OF FUNCTIONS ********************************************/